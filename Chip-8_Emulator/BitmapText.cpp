@@ -0,0 +1,134 @@
+//
+//  BitmapText.cpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#include "BitmapText.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace chp {
+
+bool BitmapFont::load(sf::Font const& font, unsigned int characterSize) {
+    float advance = 0.f;
+    for (char character = FIRST_CHARACTER; character <= LAST_CHARACTER; ++character)
+        advance = std::max(advance, font.getGlyph(character, characterSize, false).advance);
+
+    m_cellSize = {std::ceil(advance), std::ceil(font.getLineSpacing(characterSize))};
+
+    // Every glyph is now rasterized in the font page, which is read back only once
+    sf::Image const page {font.getTexture(characterSize).copyToImage()};
+
+    unsigned int const nbCharacters = LAST_CHARACTER - FIRST_CHARACTER + 1;
+    unsigned int const cellWidth = static_cast<unsigned int>(m_cellSize.x);
+    unsigned int const cellHeight = static_cast<unsigned int>(m_cellSize.y);
+
+    sf::Image atlas;
+    atlas.create(cellWidth * ATLAS_COLUMNS, cellHeight * ((nbCharacters + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS), sf::Color::Transparent);
+
+    for (char character = FIRST_CHARACTER; character <= LAST_CHARACTER; ++character) {
+        auto const& glyph {font.getGlyph(character, characterSize, false)};
+        auto const cell {getCellPosition(character)};
+
+        // Glyph is placed on the baseline, which is one character size below the top of the cell
+        int const originX = static_cast<int>(cell.x) + static_cast<int>(glyph.bounds.left);
+        int const originY = static_cast<int>(cell.y) + static_cast<int>(characterSize + glyph.bounds.top);
+
+        for (int y = 0; y < glyph.textureRect.height; ++y) {
+            for (int x = 0; x < glyph.textureRect.width; ++x) {
+                int const atlasX = originX + x;
+                int const atlasY = originY + y;
+                if (atlasX < cell.x || atlasX >= cell.x + cellWidth || atlasY < cell.y || atlasY >= cell.y + cellHeight)
+                    continue;
+                atlas.setPixel(atlasX, atlasY, page.getPixel(glyph.textureRect.left + x, glyph.textureRect.top + y));
+            }
+        }
+    }
+
+    return m_texture.loadFromImage(atlas);
+}
+
+sf::Vector2f BitmapFont::getCellPosition(char character) const {
+    if (character < FIRST_CHARACTER || character > LAST_CHARACTER)
+        character = '?';
+
+    unsigned int const cellId = character - FIRST_CHARACTER;
+    return {(cellId % ATLAS_COLUMNS) * m_cellSize.x, (cellId / ATLAS_COLUMNS) * m_cellSize.y};
+}
+
+void BitmapText::setFont(BitmapFont const& font) {
+    if (m_font == &font)
+        return;
+    m_font = &font;
+    update();
+}
+
+void BitmapText::setLineSpacing(float lineSpacing) {
+    if (m_lineSpacing == lineSpacing)
+        return;
+    m_lineSpacing = lineSpacing;
+    update();
+}
+
+void BitmapText::setFillColor(sf::Color const& color) {
+    if (m_color == color)
+        return;
+    m_color = color;
+    for (std::size_t vertexId = 0; vertexId < m_vertexCount; ++vertexId)
+        m_vertices[vertexId].color = m_color;
+}
+
+void BitmapText::setString(std::string const& string) {
+    if (m_string == string)
+        return;
+    m_string = string;
+    update();
+}
+
+void BitmapText::draw(sf::RenderTarget & target, sf::RenderStates states) const {
+    if (!m_font || m_vertexCount == 0)
+        return;
+
+    states.transform *= getTransform();
+    states.texture = &m_font->getTexture();
+    target.draw(&m_vertices[0], m_vertexCount, sf::Quads, states);
+}
+
+void BitmapText::update() {
+    m_vertexCount = 0;
+    if (!m_font)
+        return;
+
+    auto const cellSize {m_font->getCellSize()};
+    float const lineHeight = cellSize.y * m_lineSpacing;
+
+    std::size_t const nbVisibleCharacters = std::count_if(m_string.begin(), m_string.end(), [](char character) {
+        return character != ' ' && character != '\n';
+    });
+    if (m_vertices.getVertexCount() < nbVisibleCharacters * 4)
+        m_vertices.resize(nbVisibleCharacters * 4);
+
+    float x = 0.f;
+    float y = 0.f;
+    for (char character : m_string) {
+        if (character == '\n') {
+            x = 0.f;
+            y += lineHeight;
+            continue;
+        }
+        if (character != ' ') {
+            auto const cell {m_font->getCellPosition(character)};
+
+            m_vertices[m_vertexCount++] = sf::Vertex({x, y}, m_color, cell);
+            m_vertices[m_vertexCount++] = sf::Vertex({x + cellSize.x, y}, m_color, {cell.x + cellSize.x, cell.y});
+            m_vertices[m_vertexCount++] = sf::Vertex({x + cellSize.x, y + cellSize.y}, m_color, {cell.x + cellSize.x, cell.y + cellSize.y});
+            m_vertices[m_vertexCount++] = sf::Vertex({x, y + cellSize.y}, m_color, {cell.x, cell.y + cellSize.y});
+        }
+        x += cellSize.x;
+    }
+}
+
+}
@@ -0,0 +1,152 @@
+//
+//  BitmapText.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef BitmapText_hpp
+#define BitmapText_hpp
+
+# include <string>
+
+# include <SFML/Graphics.hpp>
+
+namespace chp {
+
+/**
+ \brief Class to represent a monospaced bitmap font
+ \details Printable ASCII glyphs of a TTF font are rasterized once at a given size into a texture atlas made of fixed size cells
+ */
+class BitmapFont {
+public:
+    /**
+     \brief Default constructor
+     */
+    BitmapFont() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~BitmapFont() = default;
+
+    /**
+     \brief Deleted copy constructor
+     */
+    BitmapFont(BitmapFont const& other) = delete;
+
+    /**
+     \brief Deleted assignement operator
+     */
+    BitmapFont& operator=(BitmapFont const& other) = delete;
+
+
+    /**
+     \brief Rasterizes glyphs of given font into atlas
+     \param font Font to rasterize
+     \param characterSize Size of characters in pixels
+     \return True if atlas could be created
+     */
+    bool load(sf::Font const& font, unsigned int characterSize);
+
+    /**
+     \brief Gets atlas texture
+     \return The texture storing all glyphs
+     */
+    sf::Texture const& getTexture() const {
+        return m_texture;
+    }
+
+    /**
+     \brief Gets size of a character cell
+     \return Width is the advance of every character, height is the font line spacing
+     */
+    sf::Vector2f getCellSize() const {
+        return m_cellSize;
+    }
+
+    /**
+     \brief Gets position of character cell in atlas
+     \param character Character to find. Characters not rasterized are drawn as '?'.
+     \return Position of top left corner of the cell in atlas
+     */
+    sf::Vector2f getCellPosition(char character) const;
+
+private:
+    static constexpr char FIRST_CHARACTER = ' ';
+    static constexpr char LAST_CHARACTER = '~';
+    static constexpr unsigned int ATLAS_COLUMNS = 16;
+
+    sf::Texture m_texture;
+    sf::Vector2f m_cellSize;
+};
+
+/**
+ \brief Class to draw text with a bitmap font
+ \details All characters are drawn with a single vertex array which is updated in place when string changes
+ */
+class BitmapText : public sf::Drawable, public sf::Transformable {
+public:
+    /**
+     \brief Default constructor
+     */
+    BitmapText() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~BitmapText() = default;
+
+
+    /**
+     \brief Sets font used to draw text
+     \param font Font to use, must outlive this text
+     */
+    void setFont(BitmapFont const& font);
+
+    /**
+     \brief Sets line spacing factor
+     \param lineSpacing Factor applied on the font line spacing
+     */
+    void setLineSpacing(float lineSpacing);
+
+    /**
+     \brief Sets text color
+     \param color Color of the characters
+     */
+    void setFillColor(sf::Color const& color);
+
+    /**
+     \brief Sets string to draw
+     \details Nothing is done if string did not change. Vertex array only grows, so updating a string of similar length does not allocate.
+     \param string String to draw, lines are separated with '\\n'
+     */
+    void setString(std::string const& string);
+
+protected:
+    /**
+     \brief Draws text on target
+     \param target Target where to draw text
+     \param states States used to draw text
+     */
+    void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+private:
+    /**
+     \brief Rebuilds vertex array from current string
+     */
+    void update();
+
+private:
+    BitmapFont const* m_font = nullptr;
+    std::string m_string;
+    float m_lineSpacing = 1.f;
+    sf::Color m_color = sf::Color::White;
+
+    sf::VertexArray m_vertices {sf::Quads};
+    std::size_t m_vertexCount = 0;
+};
+
+}
+
+#endif /* BitmapText_hpp */
@@ -9,13 +9,25 @@
 
 namespace chp {
 
-void Chip8::launch(std::string const& configFilename) {
+Chip8::~Chip8() {
+    stopEmulation();
+}
+
+void Chip8::launch(std::string const& configFilename, bool isStartupProfiled) {
+    if (isStartupProfiled)
+        m_startupProfile.start();
+    
     init(configFilename);
     
     sf::RenderWindow gameWindow(sf::VideoMode(m_windowWidth, m_windowHeight), "Chip-8");
+    gameWindow.setVerticalSyncEnabled(m_verticalSync);
+    m_startupProfile.mark("window created");
+    
+    startEmulation();
+    m_startupProfile.mark("emulation started");
     
-    m_executionTimer.restart();
-    m_displayTimer.restart();
+    if (m_isVideoRecorded)
+        startVideoRecording();
     
     while (gameWindow.isOpen()) {
         sf::Event event;
@@ -32,51 +44,152 @@ void Chip8::launch(std::string const& configFilename) {
             
         }
         
-        if (1.f / m_executionTimer.getElapsedTime().asSeconds() <= m_frequency && (!m_isPaused || m_doSingleJump)) {
-            update();
-            m_executionTimer.restart();
-            m_doSingleJump = false;
+        if (m_hasEmulationFailed.load(std::memory_order_acquire)) {
+            stopEmulation();
+            std::rethrow_exception(m_emulationError);
         }
         
-        if (1.f / m_displayTimer.getElapsedTime().asSeconds() <= m_fps) {
+        if (m_displayScheduler.isFrameDue(FrameScheduler::Clock::now(), m_verticalSync)) {
+            m_frames.update();
+            
             gameWindow.clear(sf::Color::Black);
             
             sf::Sprite sprite;
-            auto texture {display()};
-            sprite.setTexture(texture->getTexture());
+            auto const& texture {display(m_frames.front())};
+            sprite.setTexture(texture.getTexture());
             gameWindow.draw(sprite);
             
             gameWindow.display();
             
-            m_displayTimer.restart();
+            if (m_videoRecorder.isRecording())
+                recordVideoFrame(m_frames.front().state.pixels);
+            
+            if (m_startupProfile.isEnabled()) {
+                m_startupProfile.mark("first frame displayed");
+                m_startupProfile.print(std::cout);
+            }
         }
+        
+        if (!m_verticalSync)
+            m_displayScheduler.waitNextFrame();
     }
+    
+    stopEmulation();
+    stopVideoRecording();
 }
 
 void Chip8::init(std::string const& configFilename) {
-    srand(static_cast<unsigned int>(time(nullptr)));
+    m_randomGenerator.seed(static_cast<unsigned int>(time(nullptr)));
     
     loadConfig(configFilename);
+    m_startupProfile.mark("config and game loaded");
     clearScreen();
     loadFont();
     
-    loadOpcodes();
     loadActions();
+    m_startupProfile.mark("actions loaded");
     
     m_windowWidth = m_screenWidth * (m_showOpcodes || m_showMemory ? 1.4f : 1.f);
     m_windowHeight = m_screenHeigth * (m_showDebugInfos || m_showMemory ? 1.7f : 1.f);
     
+    loadTextFonts();
+    m_startupProfile.mark("text fonts rasterized");
+    
+    if (m_showHexViewer) {
+        m_hexViewerWidth = m_hexViewerFont.getCellSize().x * (4 + NB_HEX_BYTES_PER_ROW * 4 + 4);
+        m_windowWidth += m_hexViewerWidth;
+    }
+    
+    reset();
+}
+
+void Chip8::initHeadless(std::vector<std::uint8_t> const& game, std::uint8_t quirks, std::size_t memorySize) {
+    if (memorySize <= m_memoryBegin)
+        throw std::runtime_error("Error: memory_size must be greater than memory_start");
+    
+    m_randomGenerator.seed(0);
+    m_quirks = quirks;
+    m_memorySize = memorySize;
+    
+    m_memory.resize(m_memorySize);
+    m_stack.assign(m_maxStackSize, 0);
+    std::fill(m_registers.begin(), m_registers.end(), 0);
+    
+    loadFont();
+    m_memory.load(m_memoryBegin, game.data(), game.size());
+    m_controlFlowGraph.analyze(game.data(), game.size(), m_memoryBegin);
+    
+    loadActions();
+    
+    m_isSoundMuted = true;
+    m_isPaused = false;
+    
+    reset();
+}
+
+void Chip8::runHeadless(std::uint64_t nbCycles, std::vector<KeyInput> const& inputs) {
+    auto input {inputs.begin()};
+    
+    for (std::uint64_t cycleId = 0; cycleId < nbCycles; ++cycleId) {
+        for (; input != inputs.end() && input->cycle <= m_cycle; ++input) {
+            if (input->keyId < m_keyPressed.size())
+                m_keyPressed[input->keyId] = input->isPressed;
+        }
+        
+        if (!isInstrumented()) {
+            update();
+            if (m_memory.hasTrapped()) {
+                takeMemoryTrap();
+                break;
+            }
+        } else if (!updateInstrumented()) {
+            break;
+        }
+    }
+}
+
+void Chip8::reset() {
+    setHighResolution(false);
+    m_selectedPlanes = 0x1;
+    std::fill(m_rplFlags.begin(), m_rplFlags.end(), 0);
+    
+    std::fill(m_audioPattern.begin(), m_audioPattern.end(), 0);
+    m_audioPitch = 64;
+    m_hasAudioPattern = false;
+    m_isAudioPatternDirty = true;
+    
     m_programCounter = m_memoryBegin;
     m_stackLevel = 0;
     m_gameCounter = 0;
     m_soundCounter = 0;
     m_registerAdress = 0;
+    m_cycle = 0;
     
     m_doSingleJump = false;
     
     m_opcodesDisplayBegining = 0;
+    m_disassemblyCache.clear();
+    m_isOpcodesTextValid = false;
+    
+    m_hexViewerBegining = 0;
+    
+    m_coverage.reset(m_isCoverageEnabled, m_memorySize);
+    m_decodedInstructions.assign(m_memory.getSize(), {}); // Memory and actions may have been reloaded
+    predecodeInstructions();
+    
+    m_nbRewindSnapshots = 0;
+    m_lastRewindCycle = 0;
+    m_nbWrites = 0;
     
     std::fill(m_keyPressed.begin(), m_keyPressed.end(), false);
+    
+    m_scheduler.reset(m_frequency, m_fps);
+    m_displayScheduler.reset(m_frequency, m_fps);
+    
+    m_runAheadPixels = Planes();
+    m_breakReason.clear();
+    m_inputQueue.clear(); // Emulation thread is not running during init
+    m_inputLog.clear();
 }
 
 void Chip8::loadConfig(std::string const& configFilename) {
@@ -93,306 +206,229 @@ void Chip8::loadConfig(std::string const& configFilename) {
     
     m_frequency = parser.get<decltype(m_frequency)>("update_frequency").value_or(m_frequency);
     m_fps = parser.get<decltype(m_fps)>("framerate").value_or(m_fps);
+    m_verticalSync = parser.get<decltype(m_verticalSync)>("vertical_sync").value_or(m_verticalSync);
+    m_runAheadFrames = parser.get<decltype(m_runAheadFrames)>("run_ahead").value_or(m_runAheadFrames);
+    
+    m_tracer.resize(parser.get<std::size_t>("trace_size").value_or(0));
+    m_traceFilename = parser.get<decltype(m_traceFilename)>("trace_file").value_or(m_traceFilename);
+    
+    m_isCoverageEnabled = parser.get<decltype(m_isCoverageEnabled)>("coverage").value_or(m_isCoverageEnabled);
+    m_coverageFilename = parser.get<decltype(m_coverageFilename)>("coverage_file").value_or(m_coverageFilename);
+    m_screenshotFilename = parser.get<decltype(m_screenshotFilename)>("screenshot_file").value_or(m_screenshotFilename);
+    m_videoFilename = parser.get<decltype(m_videoFilename)>("video_file").value_or(m_videoFilename);
+    m_isVideoRecorded = parser.get<decltype(m_isVideoRecorded)>("record_video").value_or(m_isVideoRecorded);
+    
+    m_debugger.load(parser.get<std::string>("breakpoints").value_or("none"), parser.get<std::string>("watchpoints").value_or("none"));
+    setWatchpointHooks();
+    
+    auto const outOfRange {parser.get<std::string>("memory_out_of_range").value_or("wrap")};
+    if (auto const policy {MemoryBus::parseOutOfRangePolicy(outOfRange)})
+        m_memory.setOutOfRangePolicy(*policy);
+    else
+        std::cout << "Error: unknown memory_out_of_range value " << outOfRange << ", wrap is used" << std::endl;
+    
+    auto const quirks {parser.get<std::string>("quirks").value_or("none")};
+    if (auto const parsedQuirks {parseQuirks(quirks)})
+        m_quirks = *parsedQuirks;
+    else {
+        m_quirks = 0;
+        std::cout << "Error: unknown quirks " << quirks << ", none are used" << std::endl;
+    }
     
     m_gameFilename = parser.get<decltype(m_gameFilename)>("file").value_or(m_gameFilename);
+    m_romDatabaseFilename = parser.get<decltype(m_romDatabaseFilename)>("rom_database").value_or(m_romDatabaseFilename);
+    m_gamesDirectory = parser.get<decltype(m_gamesDirectory)>("games_directory").value_or(m_gamesDirectory);
     m_soundFilename = parser.get<decltype(m_soundFilename)>("sound").value_or(m_soundFilename);
     m_fontFilename = parser.get<decltype(m_fontFilename)>("font").value_or(m_fontFilename);
     
     m_showDebugInfos = parser.get<decltype(m_showDebugInfos)>("show_infos").value_or(m_showDebugInfos);
     m_showOpcodes = parser.get<decltype(m_showOpcodes)>("show_opcodes").value_or(m_showOpcodes);
     m_showMemory = parser.get<decltype(m_showMemory)>("show_memory").value_or(m_showMemory);
+    m_showHexViewer = parser.get<decltype(m_showHexViewer)>("show_hex_viewer").value_or(m_showHexViewer);
+    
+    if (auto const palette {parser.get<std::string>("palette")}; palette && !loadPalette(*palette))
+        std::cout << "Error: could not parse palette " << *palette << std::endl;
     
     m_memorySize = parser.get<decltype(m_memorySize)>("memory_size").value_or(m_memorySize);
     m_memoryBegin = parser.get<decltype(m_memoryBegin)>("memory_start").value_or(m_memoryBegin);
     m_maxStackSize = parser.get<decltype(m_maxStackSize)>("max_stack_depth").value_or(m_maxStackSize);
     
+    m_width = parser.get<decltype(m_width)>("width_resolution").value_or(m_width);
+    m_height = parser.get<decltype(m_height)>("height_resolution").value_or(m_height);
+    
+    if (m_memorySize <= m_memoryBegin || m_maxStackSize == 0)
+        throw std::runtime_error("Error: memory_size must be greater than memory_start and max_stack_depth must not be 0");
+    
     m_memory.resize(m_memorySize);
     m_stack.resize(m_maxStackSize);
-    m_pixels.resize(m_width * m_height);
     
-    std::fill(m_memory.begin(), m_memory.end(), 0);
     std::fill(m_registers.begin(), m_registers.end(), 0);
     
-    m_width = parser.get<decltype(m_width)>("width_resolution").value_or(m_width);
-    m_height = parser.get<decltype(m_height)>("height_resolution").value_or(m_height);
+    m_configQuirks = m_quirks;
+    m_configFrequency = m_frequency;
+    m_configControlKeys = m_controlKeys;
     
     if (!loadFile(m_gameFilename))
         throw std::runtime_error("Error: could not load game from file " + m_gameFilename);
-    if (!m_defaultSound.openFromFile(m_soundFilename))
+    if (m_romDatabaseFilename != "none") {
+        if (m_romDatabase.load(m_romDatabaseFilename))
+            applyRomProfile();
+        else
+            std::cout << "Error: could not load ROM database " << m_romDatabaseFilename << std::endl;
+    }
+    if (m_gamesDirectory != "none" && !m_romBrowser.open(m_gamesDirectory, m_gameFilename))
+        std::cout << "Error: could not read games directory " << m_gamesDirectory << std::endl;
+    
+    // Sound and font files are only opened when used, but missing files are still reported at startup
+    if (!std::filesystem::exists(m_soundFilename))
         throw std::runtime_error("Error: could not load sound from file " + m_soundFilename);
-    if (!m_defaultFont.loadFromFile(m_fontFilename))
-        throw std::runtime_error("Error: could not load font from file " + m_fontFilename);
+    m_isDefaultSoundLoaded = false;
     
     std::cout << "Succesfully loaded " << m_configFilename << std::endl;
 }
 
 void Chip8::loadFont() {
-    m_memory[0]=0xF0; m_memory[1]=0x90; m_memory[2]=0x90;m_memory[3]=0x90; m_memory[4]=0xF0; // O
-    
-    m_memory[5]=0x20;m_memory[6]=0x60;m_memory[7]=0x20;m_memory[8]=0x20;m_memory[9]=0x70; // 1
-    
-    m_memory[10]=0xF0;m_memory[11]=0x10;m_memory[12]=0xF0;m_memory[13]=0x80; m_memory[14]=0xF0; // 2
+    m_memory.load(SMALL_FONT_ADRESS, SMALL_FONT.data(), SMALL_FONT.size());
+    m_memory.load(BIG_FONT_ADRESS, BIG_FONT.data(), BIG_FONT.size());
+}
+
+void Chip8::loadTextFonts() {
+    if (!m_showOpcodes && !m_showMemory && !m_showDebugInfos && !m_showHexViewer)
+        return; // Font file is not needed without debug panels
     
-    m_memory[15]=0xF0;m_memory[16]=0x10;m_memory[17]=0xF0;m_memory[18]=0x10;m_memory[19]=0xF0; // 3
+    if (!m_defaultFont.loadFromFile(m_fontFilename))
+        throw std::runtime_error("Error: could not load font from file " + m_fontFilename);
     
-    m_memory[20]=0x90;m_memory[21]=0x90;m_memory[22]=0xF0;m_memory[23]=0x10;m_memory[24]=0x10; // 4
+    if (m_showOpcodes) {
+        auto const opcodesCharacterSize {static_cast<unsigned int>(m_screenHeigth * 0.98f / (NB_OPCODES_ROWS * 1.5f))};
+        if (!m_opcodesFont.load(m_defaultFont, opcodesCharacterSize))
+            throw std::runtime_error("Error: could not rasterize font from file " + m_fontFilename);
+        
+        m_opcodesText.setFont(m_opcodesFont);
+        m_opcodesText.setLineSpacing(1.55f * m_screenHeigth / 800.f);
+        m_opcodesText.setFillColor(sf::Color::White);
+        m_opcodesText.setPosition(20.f, 6.f);
+    }
     
-    m_memory[25]=0xF0;m_memory[26]=0x80;m_memory[27]=0xF0;m_memory[28]=0x10;m_memory[29]=0xF0; // 5
+    if (m_showMemory) {
+        if (!m_memoryFont.load(m_defaultFont, MEMORY_CHARACTER_SIZE))
+            throw std::runtime_error("Error: could not rasterize font from file " + m_fontFilename);
+        
+        m_memoryText.setFont(m_memoryFont);
+        m_memoryText.setLineSpacing((1.8f - (m_screenHeigth <= 700 ? 0.1f : 0.f)) * m_screenHeigth / 800.f);
+        m_memoryText.setFillColor(sf::Color::White);
+        m_memoryText.setPosition(10.f, 7.f);
+    }
     
-    m_memory[30]=0xF0;m_memory[31]=0x80;m_memory[32]=0xF0;m_memory[33]=0x90;m_memory[34]=0xF0; // 6
+    if (m_showDebugInfos) {
+        if (!m_debugInfosFont.load(m_defaultFont, DEBUG_INFOS_CHARACTER_SIZE))
+            throw std::runtime_error("Error: could not rasterize font from file " + m_fontFilename);
+        
+        m_debugInfosText.setFont(m_debugInfosFont);
+        m_debugInfosText.setLineSpacing(1.1f * m_screenHeigth / 800.f);
+        m_debugInfosText.setFillColor(sf::Color::White);
+        m_debugInfosText.setPosition(20.f, 0.f);
+    }
     
-    m_memory[35]=0xF0;m_memory[36]=0x10;m_memory[37]=0x20;m_memory[38]=0x40;m_memory[39]=0x40; // 7
+    if (m_showHexViewer) {
+        auto const hexViewerCharacterSize {static_cast<unsigned int>(m_windowHeight * 0.98f / (NB_HEX_ROWS * 1.25f))};
+        if (!m_hexViewerFont.load(m_defaultFont, hexViewerCharacterSize))
+            throw std::runtime_error("Error: could not rasterize font from file " + m_fontFilename);
+        
+        m_hexViewerText.setFont(m_hexViewerFont);
+        m_hexViewerText.setLineSpacing(1.f);
+        m_hexViewerText.setFillColor(sf::Color::White);
+        m_hexViewerText.setPosition(m_hexViewerFont.getCellSize().x * 2, 0.f);
+    }
+}
+
+bool Chip8::loadFile(std::string fileName) {
+    std::ifstream sourceFile;
+    sourceFile.open(fileName, std::ifstream::in | std::ifstream::binary);
     
-    m_memory[40]=0xF0;m_memory[41]=0x90;m_memory[42]=0xF0;m_memory[43]=0x90;m_memory[44]=0xF0; // 8
+    if (!sourceFile.is_open()) {
+        std::cout << "Error: " << strerror(errno) << std::endl;
+        return false;
+    }
     
-    m_memory[45]=0xF0;m_memory[46]=0x90;m_memory[47]=0xF0;m_memory[48]=0x10;m_memory[49]=0xF0; // 9
+    std::vector<std::uint8_t> const game {std::istreambuf_iterator<char>(sourceFile), std::istreambuf_iterator<char>()};
+    m_memory.load(m_memoryBegin, game.data(), game.size());
+    m_gameHash = RomDatabase::hash(game.data(), game.size());
+    m_controlFlowGraph.analyze(game.data(), game.size(), m_memoryBegin);
     
-    m_memory[50]=0xF0;m_memory[51]=0x90;m_memory[52]=0xF0;m_memory[53]=0x90;m_memory[54]=0x90; // A
+    sourceFile.close();
     
-    m_memory[55]=0xE0;m_memory[56]=0x90;m_memory[57]=0xE0;m_memory[58]=0x90;m_memory[59]=0xE0; // B
+    return true;
+}
+
+void Chip8::applyRomProfile() {
+    auto const profile {m_romDatabase.find(m_gameHash)};
+    if (!profile) {
+        std::cout << "No profile found for game " << m_gameFilename << " (hash " << std::hex << m_gameHash << std::dec << ")" << std::endl;
+        return;
+    }
     
-    m_memory[60]=0xF0;m_memory[61]=0x80;m_memory[62]=0x80;m_memory[63]=0x80;m_memory[64]=0xF0; // C
+    if (profile->quirks) {
+        if (auto const quirks {parseQuirks(*profile->quirks)})
+            m_quirks = *quirks;
+        else
+            std::cout << "Error: unknown quirks " << *profile->quirks << " in profile " << profile->name << std::endl;
+    }
     
-    m_memory[65]=0xE0;m_memory[66]=0x90;m_memory[67]=0x90;m_memory[68]=0x90;m_memory[69]=0xE0; // D
+    m_frequency = profile->updateFrequency.value_or(m_frequency);
     
-    m_memory[70]=0xF0;m_memory[71]=0x80;m_memory[72]=0xF0;m_memory[73]=0x80;m_memory[74]=0xF0; // E
+    for (auto const& [controlName, keyName] : profile->keys) {
+        auto const control {std::find(CONTROL_NAMES.begin(), CONTROL_NAMES.end(), controlName)};
+        auto const key {ExtendedInputs::getAssociatedKey(keyName)};
+        if (control == CONTROL_NAMES.end() || key == sf::Keyboard::Unknown) {
+            std::cout << "Error: could not set " << controlName << " to " << keyName << " in profile " << profile->name << std::endl;
+            continue;
+        }
+        m_controlKeys[control - CONTROL_NAMES.begin()] = key;
+    }
     
-    m_memory[75]=0xF0;m_memory[76]=0x80;m_memory[77]=0xF0;m_memory[78]=0x80;m_memory[79]=0x80; // F
+    std::cout << "Applied profile " << profile->name << std::endl;
 }
 
-bool Chip8::loadFile(std::string fileName) {
-    std::ifstream sourceFile;
-    sourceFile.open(fileName, std::ifstream::in);
-    
-    std::uint8_t valueRead;
-    std::size_t bytesRead = 0;
-    
-    while (sourceFile.is_open() && !sourceFile.eof() && bytesRead < m_memorySize - m_memoryBegin) {
-        valueRead = sourceFile.get();
-        m_memory[m_memoryBegin + bytesRead++] = valueRead;
+void Chip8::switchGame(int offset) {
+    if (m_romBrowser.isEmpty()) {
+        std::cout << "Error: no game found in games directory " << m_gamesDirectory << std::endl;
+        return;
     }
     
-    if (!sourceFile.is_open()) {
-        std::cout << "Error: " << strerror(errno) << std::endl;
-        return false;
+    auto const game {m_romBrowser.select(offset)};
+    if (game.empty()) {
+        std::cout << "Error: could not load game from file " << m_romBrowser.getSelectedFilename() << std::endl;
+        return;
     }
     
-    sourceFile.close();
+    stopEmulation();
+    m_gameFilename = m_romBrowser.getSelectedFilename();
+    loadGame(game);
+    startEmulation();
     
-    return true;
+    std::cout << "Switched to game " << m_gameFilename << std::endl;
 }
 
-void Chip8::loadOpcodes() {
-    m_opcodeIdentifiers[0] = {
-        "0NNN",
-        0x0000,
-        0x0FFF,
-        "SYS NNN"
-    };
-    m_opcodeIdentifiers[1] = {
-        "00E0",
-        0xFFFF,
-        0x00E0,
-        "CLS"
-    };
-    m_opcodeIdentifiers[2] = {
-        "00EE",
-        0xFFFF,
-        0x00EE,
-        "RET"
-    };
-    m_opcodeIdentifiers[3] = {
-        "1NNN",
-        0xF000,
-        0x1000,
-        "JP NNN"
-    };
-    m_opcodeIdentifiers[4] = {
-        "2NNN",
-        0xF000,
-        0x2000,
-        "CALL NNN"
-    };
-    m_opcodeIdentifiers[5] = {
-        "3XNN",
-        0xF000,
-        0x3000,
-        "SE VX, NN"
-    };
-    m_opcodeIdentifiers[6] = {
-        "4XNN",
-        0xF000,
-        0x4000,
-        "SNE VX, NN"
-    };
-    m_opcodeIdentifiers[7] = {
-        "5XY0",
-        0xF00F,
-        0x5000,
-        "SE VX, VY"
-    };
-    m_opcodeIdentifiers[8] = {
-        "6XNN",
-        0xF000,
-        0x6000,
-        "LD VX, NN"
-    };
-    m_opcodeIdentifiers[9] = {
-        "7XNN",
-        0xF000,
-        0x7000,
-        "ADD VX, NN"
-    };
-    m_opcodeIdentifiers[10] = {
-        "8XY0",
-        0xF00F,
-        0x8000,
-        "LD VX, VY"
-    };
-    m_opcodeIdentifiers[11] = {
-        "8XY1",
-        0xF00F,
-        0x8001,
-        "OR VX, VY"
-    };
-    m_opcodeIdentifiers[12] = {
-        "8XY2",
-        0xF00F,
-        0x8002,
-        "AND VX, VY"
-    };
-    m_opcodeIdentifiers[13] = {
-        "BXY3",
-        0xF00F,
-        0x8003,
-        "XOR VX, VY"
-    };
-    m_opcodeIdentifiers[14] = {
-        "8XY4",
-        0xF00F,
-        0x8004,
-        "ADD VX, VY"
-    };
-    m_opcodeIdentifiers[15] = {
-        "8XY5",
-        0xF00F,
-        0x8005,
-        "SUB VX, VY"
-    };
-    m_opcodeIdentifiers[16] = {
-        "8XY6",
-        0xF00F,
-        0x8006,
-        "SHR VX"
-    };
-    m_opcodeIdentifiers[17] = {
-        "8XY7",
-        0xF00F,
-        0x8007,
-        "SUBN VX, VY"
-    };
-    m_opcodeIdentifiers[18] = {
-        "8XYE",
-        0xF00F,
-        0x800E,
-        "SHL VX"
-    };
-    m_opcodeIdentifiers[19] = {
-        "9XY0",
-        0xF00F,
-        0x9000,
-        "SNE VX, VY"
-    };
-    m_opcodeIdentifiers[20] = {
-        "ANNN",
-        0xF000,
-        0xA000,
-        "LD I, NNN"
-    };
-    m_opcodeIdentifiers[21] = {
-        "BNNN",
-        0xF000,
-        0xB000,
-        "JP V0, NNN"
-    };
-    m_opcodeIdentifiers[22] = {
-        "CXNN",
-        0xF000,
-        0xC000,
-        "RND VX, NN"
-    };
-    m_opcodeIdentifiers[23] = {
-        "DXYN",
-        0xF000,
-        0xD000,
-        "DRW VX, VY, N"
-    };
-    m_opcodeIdentifiers[24] = {
-        "EX9E",
-        0xF0FF,
-        0xE09E,
-        "SKP VX"
-    };
-    m_opcodeIdentifiers[25] = {
-        "EXA1",
-        0xF0FF,
-        0xE0A1,
-        "SKNP VX"
-    };
-    m_opcodeIdentifiers[26] = {
-        "FX07",
-        0xF0FF,
-        0xF007,
-        "LD VX, DT"
-    };
-    m_opcodeIdentifiers[27] = {
-        "FX0A",
-        0xF0FF,
-        0xF00A,
-        "LD VX, K"
-    };
-    m_opcodeIdentifiers[28] = {
-        "FX15",
-        0xF0FF,
-        0xF015,
-        "LD DT, VX"
-    };
-    m_opcodeIdentifiers[29] = {
-        "FX18",
-        0xF0FF,
-        0xF018,
-        "LD ST, VX"
-    };
-    m_opcodeIdentifiers[30] = {
-        "FX1E",
-        0xF0FF,
-        0xF01E,
-        "ADD I, VX"
-    };
-    m_opcodeIdentifiers[31] = {
-        "FX29",
-        0xF0FF,
-        0xF029,
-        "LD F, VX"
-    };
-    m_opcodeIdentifiers[32] = {
-        "FX33",
-        0xF0FF,
-        0xF033,
-        "BCD VX"
-    };
-    m_opcodeIdentifiers[33] = {
-        "FX55",
-        0xF0FF,
-        0xF055,
-        "LD [I], VX"
-    };
-    m_opcodeIdentifiers[34] = {
-        "FX65",
-        0xF0FF,
-        0xF065,
-        "LD VX, [I]"
-    };
+void Chip8::loadGame(std::vector<std::uint8_t> const& game) {
+    m_quirks = m_configQuirks;
+    m_frequency = m_configFrequency;
+    m_controlKeys = m_configControlKeys;
+    
+    m_memory.resize(m_memorySize);
+    std::fill(m_stack.begin(), m_stack.end(), 0);
+    std::fill(m_registers.begin(), m_registers.end(), 0);
+    
+    loadFont();
+    m_memory.load(m_memoryBegin, game.data(), game.size());
+    m_gameHash = RomDatabase::hash(game.data(), game.size());
+    m_controlFlowGraph.analyze(game.data(), game.size(), m_memoryBegin);
+    
+    if (m_romDatabaseFilename != "none")
+        applyRomProfile();
+    
+    loadActions();
+    reset();
 }
 
 void Chip8::loadActions() {
@@ -406,7 +442,7 @@ void Chip8::loadActions() {
     
     m_actions[2] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         if (m_stackLevel > 0)
-        m_programCounter = m_stack[--m_stackLevel];
+            m_programCounter = checkedAccess(m_stack, --m_stackLevel, "m_stack");
     };
     
     m_actions[3] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
@@ -415,10 +451,11 @@ void Chip8::loadActions() {
     };
     
     m_actions[4] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_stack[m_stackLevel] = m_programCounter;
-        
-        if (m_stackLevel < m_maxStackSize)
-            m_stackLevel++;
+        if (m_stackLevel >= m_maxStackSize) {
+            std::cout << "Error: stack overflow at adress " << m_programCounter << ", call ignored" << std::endl;
+            return;
+        }
+        checkedAccess(m_stack, m_stackLevel++, "m_stack") = m_programCounter;
         
         m_programCounter = (b3 << 8) + (b2 << 4) + b1;
         m_programCounter -= 2;
@@ -426,17 +463,17 @@ void Chip8::loadActions() {
     
     m_actions[5] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         if (m_registers[b3] == (b2 << 4) + b1)
-            m_programCounter += 2;
+            skipNextInstruction();
     };
     
     m_actions[6] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         if (m_registers[b3] != (b2 << 4) + b1)
-            m_programCounter += 2;
+            skipNextInstruction();
     };
     
     m_actions[7] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         if (m_registers[b3] == m_registers[b2])
-            m_programCounter += 2;
+            skipNextInstruction();
     };
     
     m_actions[8] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
@@ -451,18 +488,6 @@ void Chip8::loadActions() {
         m_registers[b3] = m_registers[b2];
     };
     
-    m_actions[11] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_registers[b3] |= m_registers[b2];
-    };
-    
-    m_actions[12] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_registers[b3] &= m_registers[b2];
-    };
-    
-    m_actions[13] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_registers[b3] ^= m_registers[b2];
-    };
-    
     m_actions[14] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         if (m_registers[b3] + m_registers[b2] > 0xFF)
             m_registers[0xF] = 1;
@@ -479,11 +504,6 @@ void Chip8::loadActions() {
         m_registers[b3] -= m_registers[b2];
     };
     
-    m_actions[16] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_registers[0xF] = m_registers[b3] & 0x01;
-        m_registers[b3] = m_registers[b3] >> 1;
-    };
-    
     m_actions[17] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         if (m_registers[b3] > m_registers[b2])
             m_registers[0xF] = 0;
@@ -492,41 +512,27 @@ void Chip8::loadActions() {
         m_registers[b3] = m_registers[b2] - m_registers[b3];
     };
     
-    m_actions[18] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_registers[0xF] = (m_registers[b3] >> 7);
-        m_registers[b3] = m_registers[b3] << 1;
-    };
-    
     m_actions[19] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         if (m_registers[b3] != m_registers[b2])
-            m_programCounter += 2;
+            skipNextInstruction();
     };
     
     m_actions[20] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
         m_registerAdress = (b3 << 8) + (b2 << 4) + b1;
     };
     
-    m_actions[21] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_programCounter = (b3 << 8) + (b2 << 4) + b1 + m_registers[0];
-        m_programCounter -= 2;
-    };
-    
     m_actions[22] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_registers[b3] = rand() % ((b2 << 4) + b1 + 1);
-    };
-    
-    m_actions[23] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        drawSprite(b1, b2, b3);
+        m_registers[b3] = m_randomGenerator() % ((b2 << 4) + b1 + 1);
     };
     
     m_actions[24] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        if (m_keyPressed[m_registers[b3]])
-            m_programCounter += 2;
+        if (checkedAccess(m_keyPressed, m_registers[b3] & 0xF, "m_keyPressed"))
+            skipNextInstruction();
     };
     
     m_actions[25] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        if (!m_keyPressed[m_registers[b3]])
-            m_programCounter += 2;
+        if (!checkedAccess(m_keyPressed, m_registers[b3] & 0xF, "m_keyPressed"))
+            skipNextInstruction();
     };
     
     m_actions[26] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
@@ -558,34 +564,166 @@ void Chip8::loadActions() {
     };
     
     m_actions[32] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        m_memory[m_registerAdress] = (m_registers[b3] - m_registers[b3] % 100) / 100;
-        m_memory[m_registerAdress + 1] = ((m_registers[b3] - m_registers[b3] % 10) / 10) % 10;
-        m_memory[m_registerAdress + 2] = m_registers[b3] - m_registers[m_registerAdress] * 100 - m_memory[m_registerAdress + 1] * 10;
+        writeMemory(m_registerAdress, m_registers[b3] / 100);
+        writeMemory(m_registerAdress + 1, (m_registers[b3] / 10) % 10);
+        writeMemory(m_registerAdress + 2, m_registers[b3] % 10);
+    };
+    
+    m_actions[35] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        forEachSelectedPlane([&](Framebuffer & plane) {
+            plane.scrollDown(b1);
+        });
+    };
+    
+    m_actions[36] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        forEachSelectedPlane([&](Framebuffer & plane) {
+            plane.scrollRight(4);
+        });
+    };
+    
+    m_actions[37] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        forEachSelectedPlane([&](Framebuffer & plane) {
+            plane.scrollLeft(4);
+        });
+    };
+    
+    m_actions[38] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_programCounter -= 2; // Game is over, stays on this instruction
+    };
+    
+    m_actions[39] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        setHighResolution(false);
+    };
+    
+    m_actions[40] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        setHighResolution(true);
+    };
+    
+    m_actions[41] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_registerAdress = BIG_FONT_ADRESS + 10 * (m_registers[b3] & 0xF);
+    };
+    
+    m_actions[42] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        std::copy_n(m_registers.begin(), b3 + 1, m_rplFlags.begin());
+    };
+    
+    m_actions[43] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        std::copy_n(m_rplFlags.begin(), b3 + 1, m_registers.begin());
+    };
+    
+    m_actions[44] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        forEachSelectedPlane([&](Framebuffer & plane) {
+            plane.scrollUp(b1);
+        });
+    };
+    
+    m_actions[45] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        int const step = b3 <= b2 ? 1 : -1;
+        for (int i = 0; i <= std::abs(b2 - b3); ++i)
+            writeMemory(m_registerAdress + i, m_registers[b3 + i * step]);
+    };
+    
+    m_actions[46] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        int const step = b3 <= b2 ? 1 : -1;
+        for (int i = 0; i <= std::abs(b2 - b3); ++i)
+            m_registers[b3 + i * step] = m_memory.read(m_registerAdress + i);
+    };
+    
+    m_actions[47] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_registerAdress = getOpcodeAt(m_programCounter + 2);
+        m_programCounter += 2;
+    };
+    
+    m_actions[48] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_selectedPlanes = b3 & 0x3;
+    };
+    
+    m_actions[49] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        for (std::size_t i = 0; i < m_audioPattern.size(); ++i)
+            m_audioPattern[i] = m_memory.read(m_registerAdress + i);
+        m_hasAudioPattern = true;
+        m_isAudioPatternDirty = true;
+    };
+    
+    m_actions[50] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_audioPitch = m_registers[b3];
+        m_isAudioPatternDirty = true;
+    };
+    
+    loadQuirksActions(m_quirks, std::make_index_sequence<NB_QUIRKS_COMBINATIONS>());
+}
+
+template <std::size_t... QuirksCombinations>
+void Chip8::loadQuirksActions(std::uint8_t quirks, std::index_sequence<QuirksCombinations...>) {
+    using Loader = void (Chip8::*)();
+    static constexpr std::array<Loader, sizeof...(QuirksCombinations)> loaders {&Chip8::loadQuirksActions<Quirks<QuirksCombinations>>...};
+    
+    (this->*loaders[quirks])();
+}
+
+template <typename QuirksPolicy>
+void Chip8::loadQuirksActions() {
+    m_actions[11] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_registers[b3] |= m_registers[b2];
+        if constexpr (QuirksPolicy::LOGIC_RESETS_VF)
+            m_registers[0xF] = 0;
+    };
+    
+    m_actions[12] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_registers[b3] &= m_registers[b2];
+        if constexpr (QuirksPolicy::LOGIC_RESETS_VF)
+            m_registers[0xF] = 0;
+    };
+    
+    m_actions[13] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_registers[b3] ^= m_registers[b2];
+        if constexpr (QuirksPolicy::LOGIC_RESETS_VF)
+            m_registers[0xF] = 0;
+    };
+    
+    m_actions[16] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        std::uint8_t const value = m_registers[QuirksPolicy::SHIFT_USES_VY ? b2 : b3];
+        m_registers[b3] = value >> 1;
+        m_registers[0xF] = value & 0x01;
+    };
+    
+    m_actions[18] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        std::uint8_t const value = m_registers[QuirksPolicy::SHIFT_USES_VY ? b2 : b3];
+        m_registers[b3] = value << 1;
+        m_registers[0xF] = value >> 7;
+    };
+    
+    m_actions[21] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        m_programCounter = (b3 << 8) + (b2 << 4) + b1 + m_registers[QuirksPolicy::JUMP_USES_VX ? b3 : 0];
+        m_programCounter -= 2;
+    };
+    
+    m_actions[23] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
+        drawSprite<QuirksPolicy::SPRITES_CLIP, QuirksPolicy::SPRITE_ROWS_VF>(b1, b2, b3);
     };
     
     m_actions[33] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        for (std::uint8_t i = 0; i <= b3; ++i) {
-            if (m_registerAdress + i < m_memorySize)
-                m_registers[m_registerAdress + i] = m_registers[i];
-        }
+        for (std::uint8_t i = 0; i <= b3; ++i)
+            writeMemory(m_registerAdress + i, checkedAccess(m_registers, i, "m_registers"));
+        if constexpr (QuirksPolicy::LOAD_STORE_INCREMENTS_I)
+            m_registerAdress += b3 + 1;
     };
     
     m_actions[34] = [&](std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
-        for (std::uint8_t i = 0; i <= b3; ++i) {
-            if (m_registerAdress + i < m_memorySize)
-                m_registers[i] = m_registers[m_registerAdress + i];
-        }
+        for (std::uint8_t i = 0; i <= b3; ++i)
+            checkedAccess(m_registers, i, "m_registers") = m_memory.read(m_registerAdress + i);
+        if constexpr (QuirksPolicy::LOAD_STORE_INCREMENTS_I)
+            m_registerAdress += b3 + 1;
     };
 }
 
 void Chip8::loadInputsKeys(Parser & parser) {
-    std::array<std::string, NB_CONTROLS_AVAILABLES> keyNames {"key_1", "key_2", "key_3", "key_4", "key_5", "key_6", "key_7", "key_8", "key_9", "key_A", "key_0", "key_B", "key_C", "key_D", "key_E", "key_F", "pause_key", "reload_key", "jump_key"};
-    std::array<std::string, NB_CONTROLS_AVAILABLES> defaultKeys {"A", "Z", "E", "Q", "S", "D", "W", "X", "C", "U", "I", "O", "R", "F", "V", "P", "Enter", "Delete", "Tab"};
+    std::array<std::string, NB_CONTROLS_AVAILABLES> defaultKeys {"A", "Z", "E", "Q", "S", "D", "W", "X", "C", "U", "I", "O", "R", "F", "V", "P", "Enter", "Delete", "Tab", "Up", "Down", "PageUp", "PageDown", "F9", "Backspace", "F1", "F2", "F12", "F11"};
     
     for (int keyId = 0; keyId < NB_CONTROLS_AVAILABLES; ++keyId) {
-        m_controlKeys[keyId] = ExtendedInputs::getAssociatedKey(parser.get<std::string>(keyNames[keyId]).value_or(defaultKeys[keyId]));
+        m_controlKeys[keyId] = ExtendedInputs::getAssociatedKey(parser.get<std::string>(CONTROL_NAMES[keyId]).value_or(defaultKeys[keyId]));
         if (m_controlKeys[keyId] == sf::Keyboard::Unknown) {
-            std::cout << "Error: could not get key for identifier " << keyNames[keyId] << " --> default key " << defaultKeys[keyId] << " selected" << std::endl;
+            std::cout << "Error: could not get key for identifier " << CONTROL_NAMES[keyId] << " --> default key " << defaultKeys[keyId] << " selected" << std::endl;
             m_controlKeys[keyId] = ExtendedInputs::getAssociatedKey(defaultKeys[keyId]);
         }
     }
@@ -593,27 +731,208 @@ void Chip8::loadInputsKeys(Parser & parser) {
 
 void Chip8::handleKey(sf::Keyboard::Key key, bool keyPressed) {
     for (int keyId = 0; keyId < 16; ++keyId) {
-        if (m_controlKeys[keyId] == key)
-            m_keyPressed[keyId] = keyPressed;
+        if (m_controlKeys[keyId] == key) {
+            InputEvent const input {static_cast<std::uint8_t>(keyId), keyPressed, FrameScheduler::Clock::now(), 0};
+            if (!m_inputQueue.push(input))
+                std::cout << "Error: input queue full, key " << ExtendedInputs::getKeyName(key) << " ignored" << std::endl;
+        }
     }
     
     if (key == m_controlKeys[16] && keyPressed) { // Handles pause
         m_isPaused = !m_isPaused;
     } else if (key == m_controlKeys[17] && keyPressed) { // Handles reload
+        stopEmulation();
         init(m_configFilename);
+        startEmulation();
     } else if (key == m_controlKeys[18]) { // Handles step-by-step execution
         if (keyPressed && m_isPaused)
             m_doSingleJump = true;
+    } else if (key == m_controlKeys[24]) { // Handles step back
+        if (keyPressed && m_isPaused)
+            m_doStepBack = true;
+    } else if (key == m_controlKeys[23] && keyPressed) { // Handles trace dump
+        m_doDumpTrace = true;
+    } else if (key == m_controlKeys[25] && keyPressed) { // Handles game switching
+        switchGame(-1);
+    } else if (key == m_controlKeys[26] && keyPressed) {
+        switchGame(1);
+    } else if (key == m_controlKeys[27] && keyPressed) { // Handles screenshot of the displayed frame
+        if (saveScreenshot(m_frames.front().state.pixels, m_screenshotFilename))
+            std::cout << "Screenshot written in " << m_screenshotFilename << std::endl;
+        else
+            std::cout << "Error: could not write screenshot in file " << m_screenshotFilename << " (extension must be .png or .ppm)" << std::endl;
+    } else if (key == m_controlKeys[28] && keyPressed) { // Handles video recording
+        if (m_videoRecorder.isRecording())
+            stopVideoRecording();
+        else
+            startVideoRecording();
+    } else if (m_showHexViewer && keyPressed) { // Handles hexadecimal viewer scrolling
+        if (key == m_controlKeys[19])
+            scrollHexViewer(-1);
+        else if (key == m_controlKeys[20])
+            scrollHexViewer(1);
+        else if (key == m_controlKeys[21])
+            scrollHexViewer(-static_cast<int>(NB_HEX_ROWS));
+        else if (key == m_controlKeys[22])
+            scrollHexViewer(NB_HEX_ROWS);
     }
 }
 
-void Chip8::update() {
+void Chip8::startEmulation() {
+    if (m_isEmulationRunning)
+        return;
     
-    auto const opcode {getCurrentOpcode()};
-    auto const actionId {getActionFromOpcode(opcode)};
+    publishFrame();
+    
+    m_isEmulationRunning = true;
+    m_emulationThread = std::thread(&Chip8::emulate, this);
+}
+
+void Chip8::stopEmulation() {
+    m_isEmulationRunning = false;
+    if (!m_emulationThread.joinable())
+        return;
     
-    computeAction(actionId, opcode);
+    m_emulationThread.join();
+    
+    if (m_coverage.isEnabled() && !m_coverage.dump(m_coverageFilename))
+        std::cout << "Error: could not write coverage in file " << m_coverageFilename << std::endl;
+}
+
+void Chip8::emulate() {
+    try {
+        while (m_isEmulationRunning.load(std::memory_order_acquire)) {
+            if (m_doDumpTrace.exchange(false))
+                dumpTrace();
+            
+            auto const now {FrameScheduler::Clock::now()};
+            
+            if (!m_isPaused) {
+                auto const pending {m_scheduler.pendingInstructions(now)};
+                auto const period {m_scheduler.getInstructionPeriod()};
+                auto instructionTime {m_scheduler.getInstructionDeadline() - period * pending};
+                m_breakReason.clear();
+                
+                if (!isInstrumented()) {
+                    for (std::size_t instructionId = 0; instructionId < pending; ++instructionId) {
+                        applyInputs(instructionTime);
+                        update();
+                        if (m_memory.hasTrapped()) {
+                            takeMemoryTrap();
+                            break;
+                        }
+                        instructionTime += period;
+                    }
+                } else {
+                    for (std::size_t instructionId = 0; instructionId < pending; ++instructionId) {
+                        applyInputs(instructionTime);
+                        if (!updateInstrumented())
+                            break;
+                        instructionTime += period;
+                    }
+                }
+            } else {
+                m_scheduler.skipInstructions(now);
+                applyInputs(now);
+                if (m_doSingleJump.exchange(false)) {
+                    m_breakReason.clear();
+                    if (isInstrumented()) {
+                        updateInstrumented();
+                    } else {
+                        update();
+                        if (m_memory.hasTrapped())
+                            takeMemoryTrap();
+                    }
+                }
+                if (m_doStepBack.exchange(false)) {
+                    m_breakReason.clear();
+                    stepBack();
+                }
+            }
+            
+            recordRewindSnapshot();
+            
+            if (m_scheduler.isFrameDue(now, false)) {
+                if (m_runAheadFrames > 0 && !m_isPaused)
+                    runAhead();
+                publishFrame();
+            }
+            
+            m_scheduler.waitNextDeadline(m_isPaused);
+        }
+    } catch (...) {
+        if (m_tracer.isEnabled())
+            dumpTrace();
+        m_emulationError = std::current_exception();
+        m_hasEmulationFailed.store(true, std::memory_order_release);
+    }
+}
+
+void Chip8::applyInputs(FrameScheduler::Clock::time_point instructionTime) {
+    std::uint16_t pressedKeys = 0;
+    
+    while (auto const input {m_inputQueue.front()}) {
+        if (input->timestamp > instructionTime)
+            break;
+        if (!input->isPressed && (pressedKeys & (0x1 << input->keyId)))
+            break; // Release is applied at next instruction so that the press is seen
+        
+        if (input->isPressed)
+            pressedKeys |= 0x1 << input->keyId;
+        
+        m_keyPressed[input->keyId] = input->isPressed;
+        m_inputLog.push_back(*input);
+        m_inputLog.back().cycle = m_cycle;
+        
+        m_inputQueue.pop();
+    }
+}
+
+void Chip8::publishFrame() {
+    auto & frame {m_frames.back()};
+    auto & state {frame.state};
+    
+    frame.isPaused = m_isPaused;
+    state.pixels = m_runAheadFrames > 0 && !frame.isPaused && !m_runAheadPixels[0].isEmpty() ? m_runAheadPixels : m_pixels;
+    state.registers = m_registers;
+    state.programCounter = m_programCounter;
+    state.stackLevel = m_stackLevel;
+    state.registerAdress = m_registerAdress;
+    state.gameCounter = m_gameCounter;
+    state.soundCounter = m_soundCounter;
+    state.cycle = m_cycle;
+    state.recentWrites = m_recentWrites;
+    state.nbWrites = m_nbWrites;
+    
+    // Memory is only copied for the panels reading it, and only if it changed since this buffer was published
+    if ((m_showOpcodes || m_showHexViewer) && frame.memoryGeneration != m_memory.getGeneration()) {
+        state.memory = m_memory.getData();
+        frame.memoryGeneration = m_memory.getGeneration();
+    }
+    
+    frame.runAheadCost = m_runAheadCost;
+    frame.breakReason = m_breakReason;
+    frame.isCoverageEnabled = m_coverage.isEnabled();
+    frame.nbVisited = m_coverage.getNbVisited();
+    
+    // Opcodes panel shows the rows around program counter, so only their counts are copied
+    frame.executionCounts.clear();
+    if (m_showOpcodes && m_coverage.isEnabled()) {
+        auto const& counts {m_coverage.getCounts()};
+        frame.executionCountsBegin = std::min<std::size_t>(m_programCounter >= NB_OPCODES_ROWS * 2 ? m_programCounter - NB_OPCODES_ROWS * 2 : 0, counts.size());
+        auto const end {std::min(frame.executionCountsBegin + NB_OPCODES_ROWS * 4, counts.size())};
+        frame.executionCounts.assign(counts.begin() + frame.executionCountsBegin, counts.begin() + end);
+    }
+    
+    m_frames.publish();
+}
+
+void Chip8::update() {
+    
+    auto const& instruction {getCurrentInstruction()};
+    (*instruction.action)(instruction.b1, instruction.b2, instruction.b3);
     m_programCounter += 2;
+    m_cycle++;
     
     if (m_gameCounter > 0)
         m_gameCounter--;
@@ -621,243 +940,606 @@ void Chip8::update() {
     // https://opengameart.org/content/512-sound-effects-8-bit-style
     
     if (m_soundCounter > 0) {
-        m_defaultSound.stop();
-        m_defaultSound.play();
+        if (!m_isSoundMuted) {
+            if (m_hasAudioPattern) {
+                playAudioPattern();
+            } else {
+                playDefaultSound();
+            }
+        }
         m_soundCounter--;
+        if (m_soundCounter == 0 && m_hasAudioPattern && !m_isSoundMuted)
+            getAudio().patternSound.stop();
+    }
+}
+
+bool Chip8::updateInstrumented() {
+    auto const programCounter {m_programCounter};
+    auto const opcode {getCurrentOpcode()};
+    
+    update();
+    
+    if (m_coverage.isEnabled())
+        m_coverage.record(programCounter);
+    if (m_tracer.isEnabled())
+        m_tracer.record({programCounter, opcode, m_registerAdress, m_registers[(opcode & 0x0F00) >> 8], m_registers[0xF]}, m_registers);
+    
+    if (m_memory.hasTrapped()) {
+        takeMemoryTrap();
+        return false;
+    }
+    
+    if (!m_debugger.hasBreakpoints())
+        return true;
+    
+    if (auto const reason {m_debugger.check(m_programCounter, m_registers)}) {
+        m_breakReason = *reason;
+        m_isPaused = true;
+        return false;
+    }
+    return true;
+}
+
+bool Chip8::isInstrumented() const {
+    return m_debugger.hasBreakpoints() || m_tracer.isEnabled() || m_coverage.isEnabled();
+}
+
+void Chip8::dumpTrace() {
+    if (!m_tracer.isEnabled()) {
+        std::cout << "Error: tracing is disabled, set trace_size to record a trace" << std::endl;
+        return;
+    }
+    
+    if (m_tracer.dump(m_traceFilename, m_cycle))
+        std::cout << "Trace written in " << m_traceFilename << std::endl;
+    else
+        std::cout << "Error: could not write trace in file " << m_traceFilename << std::endl;
+}
+
+bool Chip8::decodeTrace(std::string const& traceFilename, std::ostream & output) {
+    std::vector<Tracer::Entry> entries;
+    std::uint64_t cycle;
+    if (!Tracer::load(traceFilename, entries, cycle))
+        return false;
+    
+    std::uint64_t nbInstructions = 0;
+    for (std::size_t entryId = 0; entryId < entries.size(); entryId += 1 + Tracer::getNbRegisterEntries(entries[entryId].opcode))
+        ++nbInstructions;
+    
+    std::uint64_t entryCycle = cycle - nbInstructions;
+    for (std::size_t entryId = 0; entryId < entries.size();) {
+        auto const& entry {entries[entryId++]};
+        auto const mnemonic {OPCODES[decodeOpcode(entry.opcode)].mnemonic};
+        
+        char line[96];
+        std::snprintf(line, sizeof(line), "%10llu  %04X  %04X  %-14.*s I=%04X VX=%02X VF=%02X",
+                      static_cast<unsigned long long>(entryCycle++), entry.programCounter, entry.opcode, static_cast<int>(mnemonic.size()), mnemonic.data(),
+                      entry.registerAdress, entry.registerX, entry.registerF);
+        output << line;
+        
+        // Registers loaded by FX65, 5XY3 and FX85 are stored in the following entries
+        auto const range {Tracer::getWrittenRegisters(entry.opcode)};
+        for (std::size_t registerId = 0; registerId < range.nbRegisters && entryId < entries.size(); registerId += 8) {
+            auto const values {Tracer::unpackRegisters(entries[entryId++])};
+            for (std::size_t valueId = 0; valueId < 8 && registerId + valueId < range.nbRegisters; ++valueId) {
+                std::snprintf(line, sizeof(line), " V%X=%02X", static_cast<unsigned int>(range.first + registerId + valueId), values[valueId]);
+                output << line;
+            }
+        }
+        output << "\n";
+    }
+    
+    return true;
+}
+
+void Chip8::takeMemoryTrap() {
+    m_breakReason = m_memory.takeTrap();
+    m_isPaused = true;
+}
+
+void Chip8::setWatchpointHooks() {
+    m_memory.clearHooks();
+    for (auto const& [first, last] : m_debugger.getWatchedRanges()) {
+        m_memory.addHook(first, last, [this](std::uint32_t adress, std::uint8_t value, bool isWrite) {
+            if (auto const reason {m_debugger.checkAccess({adress, adress + 1, isWrite})}) {
+                char access[32];
+                std::snprintf(access, sizeof(access), " (%X = %02X)", static_cast<unsigned int>(adress), value);
+                m_memory.trap(*reason + access);
+            }
+        });
     }
 }
 
-std::unique_ptr<sf::RenderTexture> Chip8::display() {
-    auto texture {std::make_unique<sf::RenderTexture>()};
-    texture->create(m_windowWidth, m_windowHeight);
-    texture->clear(sf::Color::Red);
+void Chip8::recordRewindSnapshot() {
+    if (m_nbRewindSnapshots > 0 && m_cycle < m_lastRewindCycle + REWIND_INTERVAL)
+        return;
+    
+    bool const isRingFull = m_nbRewindSnapshots >= NB_REWIND_SNAPSHOTS;
+    saveSnapshot(m_rewindSnapshots[m_nbRewindSnapshots++ % NB_REWIND_SNAPSHOTS]);
+    m_lastRewindCycle = m_cycle;
+    
+    if (!isRingFull)
+        return;
+    
+    // Inputs before the oldest snapshot can never be replayed again
+    auto const oldest {std::min_element(m_rewindSnapshots.begin(), m_rewindSnapshots.end(), [](Snapshot const& lhs, Snapshot const& rhs) {
+        return lhs.cycle < rhs.cycle;
+    })};
+    m_inputLog.erase(m_inputLog.begin(), std::lower_bound(m_inputLog.begin(), m_inputLog.end(), oldest->cycle, [](InputEvent const& input, std::uint64_t cycle) {
+        return input.cycle < cycle;
+    }));
+}
+
+void Chip8::stepBack() {
+    if (m_cycle == 0)
+        return;
+    
+    std::uint64_t const target = m_cycle - 1;
+    
+    Snapshot const* nearest = nullptr;
+    for (std::size_t snapshotId = 0; snapshotId < std::min(m_nbRewindSnapshots, NB_REWIND_SNAPSHOTS); ++snapshotId) {
+        auto const& snapshot {m_rewindSnapshots[snapshotId]};
+        if (snapshot.cycle <= target && (!nearest || snapshot.cycle > nearest->cycle))
+            nearest = &snapshot;
+    }
+    
+    if (!nearest) {
+        std::cout << "Error: cannot step back further than cycle " << m_cycle << std::endl;
+        return;
+    }
+    
+    restoreSnapshot(*nearest);
+    replayUntil(target);
+    
+    // Anything recorded after target belongs to the abandoned future
+    for (std::size_t snapshotId = 0; snapshotId < std::min(m_nbRewindSnapshots, NB_REWIND_SNAPSHOTS); ++snapshotId) {
+        if (m_rewindSnapshots[snapshotId].cycle > target)
+            m_rewindSnapshots[snapshotId].cycle = std::numeric_limits<std::uint64_t>::max();
+    }
+    
+    // Nearest snapshot is the latest valid one, so next snapshots reuse the slots that follow it
+    std::size_t const nearestId = nearest - m_rewindSnapshots.data();
+    m_nbRewindSnapshots -= (m_nbRewindSnapshots - 1 - nearestId) % NB_REWIND_SNAPSHOTS;
+    m_lastRewindCycle = nearest->cycle;
+    
+    m_inputLog.erase(std::lower_bound(m_inputLog.begin(), m_inputLog.end(), target, [](InputEvent const& input, std::uint64_t cycle) {
+        return input.cycle < cycle;
+    }), m_inputLog.end());
+}
+
+void Chip8::replayUntil(std::uint64_t cycle) {
+    auto input {std::lower_bound(m_inputLog.begin(), m_inputLog.end(), m_cycle, [](InputEvent const& input, std::uint64_t cycle) {
+        return input.cycle < cycle;
+    })};
+    
+    m_isSoundMuted = true;
+    while (m_cycle < cycle) {
+        for (; input != m_inputLog.end() && input->cycle == m_cycle; ++input)
+            m_keyPressed[input->keyId] = input->isPressed;
+        update();
+    }
+    m_isSoundMuted = false;
+    
+    if (m_memory.hasTrapped())
+        m_memory.takeTrap(); // Traps were already taken when instructions were first executed
+}
+
+void Chip8::runAhead() {
+    auto const begin {FrameScheduler::Clock::now()};
+    
+    saveSnapshot(m_runAheadSnapshot);
+    
+    m_isSoundMuted = true;
+    std::size_t const instructionsPerFrame = std::max(m_frequency / std::max(m_fps, 1), 1);
+    for (std::size_t instructionId = 0; instructionId < m_runAheadFrames * instructionsPerFrame; ++instructionId)
+        update();
+    m_isSoundMuted = false;
+    
+    m_runAheadPixels = m_pixels;
+    restoreSnapshot(m_runAheadSnapshot);
+    
+    if (m_memory.hasTrapped())
+        m_memory.takeTrap(); // Instructions will be trapped when really executed
+    
+    m_runAheadCost = std::chrono::duration<float, std::milli>(FrameScheduler::Clock::now() - begin).count();
+}
+
+sf::RenderTexture & Chip8::preparePanel(sf::RenderTexture & texture, float width, float height, sf::Color const& color) {
+    sf::Vector2u const size(static_cast<unsigned int>(width), static_cast<unsigned int>(height));
+    if (texture.getSize() != size)
+        texture.create(size.x, size.y);
+    texture.clear(color);
+    return texture;
+}
+
+sf::RenderTexture & Chip8::display(Frame const& frame) {
+    auto & texture {preparePanel(m_windowTexture, m_windowWidth, m_windowHeight, sf::Color::Red)};
     
     sf::Sprite screenSprite {};
-    auto screenTexture {displayScreen()};
-    screenSprite.setTexture(screenTexture->getTexture());
+    auto const& screenTexture {displayScreen(frame.state)};
+    screenSprite.setTexture(screenTexture.getTexture());
     screenSprite.setPosition(0.f, 0.f);
-    texture->draw(screenSprite);
+    texture.draw(screenSprite);
     
     if (m_showOpcodes) {
         sf::Sprite opcodesSprite {};
-        auto opcodesTexture {displayOpcodes()};
-        opcodesSprite.setTexture(opcodesTexture->getTexture());
+        auto const& opcodesTexture {displayOpcodes(frame)};
+        opcodesSprite.setTexture(opcodesTexture.getTexture());
         opcodesSprite.setPosition(m_screenWidth, 0.f);
-        texture->draw(opcodesSprite);
+        texture.draw(opcodesSprite);
     }
     
     if (m_showDebugInfos) {
         sf::Sprite debugSprite {};
-        auto debugTexture {displayDebugInfos()};
-        debugSprite.setTexture(debugTexture->getTexture());
+        auto const& debugTexture {displayDebugInfos(frame)};
+        debugSprite.setTexture(debugTexture.getTexture());
         debugSprite.setPosition(0.f, m_screenHeigth);
-        texture->draw(debugSprite);
+        texture.draw(debugSprite);
+    }
+    
+    if (m_showHexViewer) {
+        sf::Sprite hexViewerSprite {};
+        auto const& hexViewerTexture {displayHexViewer(frame.state)};
+        hexViewerSprite.setTexture(hexViewerTexture.getTexture());
+        hexViewerSprite.setPosition(m_windowWidth - m_hexViewerWidth, 0.f);
+        texture.draw(hexViewerSprite);
     }
     
     if (m_showMemory) {
         sf::Sprite memorySprite {};
-        auto memoryTexture {displayMemory()};
-        memorySprite.setTexture(memoryTexture->getTexture());
+        auto const& memoryTexture {displayMemory(frame.state)};
+        memorySprite.setTexture(memoryTexture.getTexture());
         memorySprite.setPosition(m_screenWidth, m_screenHeigth);
-        texture->draw(memorySprite);
+        texture.draw(memorySprite);
         
         if (!m_showOpcodes) {
-            sf::RenderTexture opcodesTexture;
-            opcodesTexture.create(m_screenWidth * 0.4f, m_screenHeigth);
-            opcodesTexture.clear(sf::Color(61, 75, 105));
+            // Placeholders of hidden panels are drawn in their texture, so that no texture is created every frame
+            auto & opcodesTexture {preparePanel(m_opcodesPanel, m_screenWidth * 0.4f, m_screenHeigth, sf::Color(61, 75, 105))};
             opcodesTexture.display();
             
             sf::Sprite opcodesSprite {};
             opcodesSprite.setTexture(opcodesTexture.getTexture());
             opcodesSprite.setPosition(m_screenWidth, 0.f);
-            texture->draw(opcodesSprite);
+            texture.draw(opcodesSprite);
         }
         if (!m_showDebugInfos) {
-            sf::RenderTexture debugTexture;
-            debugTexture.create(m_screenWidth, m_screenHeigth * 0.7f);
-            debugTexture.clear(sf::Color(59, 81, 128));
+            auto & debugTexture {preparePanel(m_debugInfosPanel, m_screenWidth, m_screenHeigth * 0.7f, sf::Color(59, 81, 128))};
             debugTexture.display();
             
             sf::Sprite debugSprite {};
             debugSprite.setTexture(debugTexture.getTexture());
             debugSprite.setPosition(0.f, m_screenHeigth);
-            texture->draw(debugSprite);
+            texture.draw(debugSprite);
         }
     }
     
-    texture->display();
+    texture.display();
     
     return texture;
 }
 
-std::unique_ptr<sf::RenderTexture> Chip8::displayScreen() {
-    const float pixelWidth = static_cast<float>(m_screenWidth) / m_width;
-    const float pixelHeight = static_cast<float>(m_screenHeigth) / m_height;
+template <typename Function>
+void Chip8::forEachColoredPixel(Planes const& planes, Function && function) {
+    std::size_t const height = planes[0].getHeight();
+    std::size_t const wordsPerRow = planes[0].getWordsPerRow();
+    
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t wordId = 0; wordId < wordsPerRow; ++wordId) {
+            std::array<std::uint64_t, NB_PLANES> words;
+            std::uint64_t anyPlane = 0;
+            for (std::size_t planeId = 0; planeId < NB_PLANES; ++planeId) {
+                words[planeId] = planes[planeId].getWords()[y * wordsPerRow + wordId];
+                anyPlane |= words[planeId];
+            }
+            
+            for (std::size_t bitId = 0; anyPlane != 0 && bitId < 64; ++bitId) {
+                std::size_t colorId = 0;
+                for (std::size_t planeId = 0; planeId < NB_PLANES; ++planeId)
+                    colorId |= ((words[planeId] >> (63 - bitId)) & 0x1) << planeId;
+                if (colorId != 0)
+                    function(wordId * 64 + bitId, y, colorId);
+            }
+        }
+    }
+}
+
+bool Chip8::saveScreenshot(std::string const& filename) const {
+    return saveScreenshot(m_pixels, filename);
+}
+
+bool Chip8::saveScreenshot(Planes const& planes, std::string const& filename) const {
+    Screenshot screenshot(planes[0].getWidth(), planes[0].getHeight());
     
-    const int textureWidth = m_width * pixelWidth;
-    const int textureHeight = m_height * pixelHeight;
+    auto const& background {m_palette[0]};
+    for (std::size_t y = 0; y < planes[0].getHeight(); ++y) {
+        for (std::size_t x = 0; x < planes[0].getWidth(); ++x)
+            screenshot.setPixel(x, y, background.r, background.g, background.b);
+    }
+    forEachColoredPixel(planes, [&](std::size_t x, std::size_t y, std::size_t colorId) {
+        auto const& color {m_palette[colorId]};
+        screenshot.setPixel(x, y, color.r, color.g, color.b);
+    });
     
-    auto texture {std::make_unique<sf::RenderTexture>()};
-    texture->create(textureWidth, textureHeight);
+    return screenshot.save(filename);
+}
+
+void Chip8::startVideoRecording() {
+    if (m_videoRecorder.start(m_videoFilename, static_cast<std::uint16_t>(m_fps)))
+        std::cout << "Recording video in " << m_videoFilename << std::endl;
+    else
+        std::cout << "Error: could not open video file " << m_videoFilename << std::endl;
+}
+
+void Chip8::stopVideoRecording() {
+    if (!m_videoRecorder.isRecording())
+        return;
     
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            sf::RectangleShape pixel;
-            pixel.setSize({pixelWidth, pixelHeight});
-            pixel.setFillColor(m_pixels[y * m_width + x] ? sf::Color::White : sf::Color::Black);
-            pixel.setPosition(x * pixelWidth, y * pixelHeight);
-            texture->draw(pixel);
+    m_videoRecorder.stop();
+    std::cout << "Video written in " << m_videoFilename << " (" << m_videoRecorder.getNbFrames() << " frames, " << m_videoRecorder.getNbDroppedFrames() << " dropped)" << std::endl;
+}
+
+void Chip8::recordVideoFrame(Planes const& planes) {
+    VideoRecorder::Frame frame;
+    frame.width = static_cast<std::uint16_t>(planes[0].getWidth());
+    frame.height = static_cast<std::uint16_t>(planes[0].getHeight());
+    frame.nbPlanes = NB_PLANES;
+    if (frame.getSize() > VideoRecorder::MAX_FRAME_SIZE)
+        return;
+    
+    // Words store 64 pixels with the leftmost one in the most significant bit, so their bytes are written most significant first
+    std::size_t const bytesPerRow = frame.getBytesPerRow();
+    std::size_t const wordsPerRow = planes[0].getWordsPerRow();
+    auto byte {frame.bits.begin()};
+    for (auto const& plane : planes) {
+        for (std::size_t y = 0; y < frame.height; ++y) {
+            for (std::size_t byteId = 0; byteId < bytesPerRow; ++byteId)
+                *byte++ = static_cast<std::uint8_t>(plane.getWords()[y * wordsPerRow + byteId / 8] >> (56 - 8 * (byteId % 8)));
         }
     }
     
-    texture->display();
+    m_videoRecorder.push(frame);
+}
+
+bool Chip8::decodeVideo(std::string const& videoFilename, std::string const& outputDirectory) const {
+    bool areImagesWritten = true;
+    std::uint64_t nbImages = 0;
+    std::uint16_t frameRate = 0;
+    
+    auto const nbFrames {VideoRecorder::decode(videoFilename, frameRate, [&](std::uint64_t frameId, VideoRecorder::Frame const& frame) {
+        Screenshot screenshot(frame.width, frame.height);
+        for (std::size_t y = 0; y < frame.height; ++y) {
+            for (std::size_t x = 0; x < frame.width; ++x) {
+                auto const& color {m_palette[frame.getColorId(x, y)]};
+                screenshot.setPixel(x, y, color.r, color.g, color.b);
+            }
+        }
+        
+        char imageName[32];
+        std::snprintf(imageName, sizeof(imageName), "frame_%08llu.png", static_cast<unsigned long long>(frameId));
+        areImagesWritten = screenshot.save((std::filesystem::path(outputDirectory) / imageName).string()) && areImagesWritten;
+        ++nbImages;
+    })};
+    
+    if (nbFrames == 0)
+        return false;
+    
+    std::cout << nbFrames << " frames at " << frameRate << " fps, " << nbImages << " images written in " << outputDirectory << std::endl;
+    return areImagesWritten;
+}
+
+sf::RenderTexture & Chip8::displayScreen(Snapshot const& state) {
+    auto const& planes {state.pixels};
+    std::size_t const width = planes[0].getWidth();
+    std::size_t const height = planes[0].getHeight();
+    
+    // Colors are looked up once per pixel here, then the whole screen is uploaded as a single texture
+    m_screenImage.create(width, height, m_palette[0]);
+    forEachColoredPixel(planes, [&](std::size_t x, std::size_t y, std::size_t colorId) {
+        m_screenImage.setPixel(x, y, m_palette[colorId]);
+    });
+    
+    if (m_screenTexture.getSize() != sf::Vector2u(width, height))
+        m_screenTexture.create(width, height);
+    m_screenTexture.update(m_screenImage);
+    
+    auto & texture {preparePanel(m_screenPanel, m_screenWidth, m_screenHeigth, sf::Color::Black)};
+    
+    sf::Sprite screen(m_screenTexture);
+    screen.setScale(static_cast<float>(m_screenWidth) / width, static_cast<float>(m_screenHeigth) / height);
+    texture.draw(screen);
+    
+    texture.display();
     
     return texture;
 }
 
-std::unique_ptr<sf::RenderTexture> Chip8::displayOpcodes() {
-    float subViewWidth = m_screenWidth * 0.4f;
-    float subViewHeight = m_screenHeigth;
+std::string const& Chip8::disassemble(Snapshot const& state, std::uint16_t adress) {
+    auto & line {m_disassemblyCache[adress]};
+    
+    std::uint16_t opcode = static_cast<std::size_t>(adress) + 1 < state.memory.size() ? (state.memory[adress] << 8) + state.memory[adress + 1] : 0;
+    
+    // Bytes of the game not reached from its entry point are shown as data, unless they are executed anyway (BNNN, self modifying code)
+    bool const isData = adress != state.programCounter && m_controlFlowGraph.contains(adress)
+        && m_controlFlowGraph.getByteKind(adress) != ControlFlowGraph::ByteKind::Instruction;
     
-    auto texture {std::make_unique<sf::RenderTexture>()};
-    texture->create(subViewWidth, subViewHeight);
-    texture->clear(sf::Color(61, 75, 105));
+    if (line.isValid && line.opcode == opcode && line.isData == isData && (!line.usesRegisterAdress || line.registerAdress == state.registerAdress))
+        return line.text;
+    
+    line.opcode = opcode;
+    line.registerAdress = state.registerAdress;
+    line.usesRegisterAdress = false;
+    line.isData = isData;
+    line.isValid = true;
+    m_isOpcodesTextValid = false;
     
     std::ostringstream stream;
     
-    int nbRows = 19;
-    unsigned int characterSize = static_cast<unsigned int>(m_screenHeigth * 0.98f / (nbRows * 1.5f));
-    unsigned int outlineThickness = 6;
-    float lineSpacing = 1.55f * m_screenHeigth / 800.f;
+    stream << std::hex << static_cast<int>(adress);
+    stream << " - ";
     
-    if (m_programCounter < m_opcodesDisplayBegining || m_programCounter - m_opcodesDisplayBegining >= (nbRows - 1) * 2) {
-        m_opcodesDisplayBegining = m_programCounter - 6;
+    if (isData) {
+        stream << "DB   #" << (opcode >> 8) << ", #" << (opcode & 0xFF);
+        line.text = stream.str();
+        return line.text;
     }
     
-    for (int adress = m_opcodesDisplayBegining; adress < m_opcodesDisplayBegining + nbRows * 2; adress += 2) {
-        stream << std::hex << static_cast<int>(adress);
-        stream << " - ";
-        
-        std::uint16_t opcode = getOpcodeAt(adress);
-        int opcodeId = static_cast<int>(getActionFromOpcode(opcode));
-        if (0 <= opcodeId && opcodeId < NB_OPCODES_AVAILABLES) {
-            std::string mnemonnic {m_opcodeIdentifiers[opcodeId].mnemonic};
-            
-            auto delimIt = std::find(mnemonnic.begin(), mnemonnic.end(), ' ');
-            std::string sub = std::string(mnemonnic.begin(), delimIt);
-            stream << sub;
-            
-            for (int delta = 0; delta < 4 - sub.size(); ++delta)
-                stream << " "; // Adds spaces to uniform values manipulated display
-            
-            std::uint8_t b3 = (opcode >> 8) & 0xF, b2 = (opcode >> 4) & 0xF, b1 = opcode & 0xF;
-            
-            std::string toParse = std::string(delimIt, mnemonnic.end());
-            for (int i = 0; i < toParse.size(); ++i) {
-                switch (toParse[i]) {
-                    case 'I':
-                        stream << static_cast<int>(m_registerAdress);
-                        break;
-                    case 'X':
-                        stream << static_cast<int>(b3);
-                        break;
-                    case 'Y':
-                        stream << static_cast<int>(b2);
-                        break;
-                    case 'N':
-                    {
-                        int addr = b3;
-                        if (++i < toParse.size() && toParse[i] == 'N') {
-                            addr = (addr << 4) + b2;
-                            if (++i < toParse.size() && toParse[i] == 'N')
-                            {
-                                addr = (addr << 4) + b1;
-                                ++i;
-                            }
-                        }
-                        --i;
-                        stream << "#" << static_cast<int>(addr);
-                    }
-                        break;
-                    default:
-                        stream << toParse[i];
-                        break;
+    auto const mnemonic {OPCODES[decodeOpcode(opcode)].mnemonic};
+    auto const delimiter {std::min(mnemonic.find(' '), mnemonic.size())};
+    stream << mnemonic.substr(0, delimiter);
+    
+    for (auto delta = delimiter; delta < 4; ++delta)
+        stream << " "; // Adds spaces to uniform values manipulated display
+    
+    auto const operands {mnemonic.substr(delimiter)};
+    for (std::size_t i = 0; i < operands.size(); ++i) {
+        switch (operands[i]) {
+            case 'I':
+                stream << static_cast<int>(state.registerAdress);
+                line.usesRegisterAdress = true;
+                break;
+            case 'X':
+                stream << static_cast<int>((opcode >> 8) & 0xF);
+                break;
+            case 'Y':
+                stream << static_cast<int>((opcode >> 4) & 0xF);
+                break;
+            case 'N':
+            {
+                if (i > 0 && std::isalpha(static_cast<unsigned char>(operands[i - 1]))) {
+                    stream << operands[i]; // Letter of a word such as LONG
+                    break;
                 }
+                
+                // N, NN and NNN are the last 1, 2 and 3 nibbles
+                int nbNibbles = 1;
+                for (; i + 1 < operands.size() && operands[i + 1] == 'N'; ++i)
+                    ++nbNibbles;
+                stream << "#" << (opcode & ((1 << (4 * nbNibbles)) - 1));
             }
+                break;
+            default:
+                stream << operands[i];
+                break;
         }
-        
-        stream << "\n";
     }
     
-    sf::Text text(stream.str(), m_defaultFont);
-    text.setCharacterSize(characterSize);
-    text.setLineSpacing(lineSpacing);
-    text.setFillColor(sf::Color::White);
-    text.setPosition(20.f, 6.f);
+    line.text = stream.str();
+    return line.text;
+}
+
+sf::RenderTexture & Chip8::displayOpcodes(Frame const& frame) {
+    auto const& state {frame.state};
+    
+    float subViewWidth = m_screenWidth * 0.4f;
+    float subViewHeight = m_screenHeigth;
+    
+    auto & texture {preparePanel(m_opcodesPanel, subViewWidth, subViewHeight, sf::Color(61, 75, 105))};
+    
+    unsigned int characterSize = static_cast<unsigned int>(m_screenHeigth * 0.98f / (NB_OPCODES_ROWS * 1.5f));
+    unsigned int outlineThickness = 6;
+    
+    if (state.programCounter < m_opcodesDisplayBegining || static_cast<std::size_t>(state.programCounter - m_opcodesDisplayBegining) >= (NB_OPCODES_ROWS - 1) * 2) {
+        m_opcodesDisplayBegining = std::min<std::size_t>(state.programCounter >= 6 ? state.programCounter - 6 : 0, state.memory.size());
+        m_isOpcodesTextValid = false;
+    }
+    
+    if (m_disassemblyCache.size() != state.memory.size() + NB_OPCODES_ROWS * 2) {
+        m_disassemblyCache.assign(state.memory.size() + NB_OPCODES_ROWS * 2, {});
+        m_isOpcodesTextValid = false;
+    }
+    
+    std::array<std::string const*, NB_OPCODES_ROWS> rows;
+    for (std::size_t rowId = 0; rowId < NB_OPCODES_ROWS; ++rowId)
+        rows[rowId] = &disassemble(state, m_opcodesDisplayBegining + rowId * 2);
+    
+    if (!m_isOpcodesTextValid) {
+        std::string content;
+        for (auto row : rows) {
+            content += *row;
+            content += "\n";
+        }
+        
+        m_opcodesText.setString(content);
+        m_isOpcodesTextValid = true;
+    }
     
     sf::RectangleShape highlightShape {};
     highlightShape.setSize(sf::Vector2f(subViewWidth - outlineThickness * 2, characterSize * 1.5f - outlineThickness * 2));
     highlightShape.setFillColor(sf::Color::Red);
     highlightShape.setOutlineColor(sf::Color(255, 128, 0));
     highlightShape.setOutlineThickness(outlineThickness);
-    highlightShape.setPosition(outlineThickness, subViewHeight / nbRows * ((m_programCounter - m_opcodesDisplayBegining) / 2) + 6.f);
-    texture->draw(highlightShape);
+    highlightShape.setPosition(outlineThickness, subViewHeight / NB_OPCODES_ROWS * ((state.programCounter - m_opcodesDisplayBegining) / 2) + 6.f);
+    texture.draw(highlightShape);
+    
+    if (!frame.executionCounts.empty()) {
+        sf::RectangleShape heatShape {{10.f, subViewHeight / NB_OPCODES_ROWS - 4.f}};
+        for (std::size_t rowId = 0; rowId < NB_OPCODES_ROWS; ++rowId) {
+            std::size_t const adress = m_opcodesDisplayBegining + rowId * 2;
+            if (adress < frame.executionCountsBegin || adress - frame.executionCountsBegin >= frame.executionCounts.size())
+                continue;
+            auto const count {frame.executionCounts[adress - frame.executionCountsBegin]};
+            if (count == 0)
+                continue;
+            
+            // Heat is logarithmic so that loops executed millions of times stay distinguishable
+            float const heat = std::min(1.f, std::log2(count + 1.f) / 24.f);
+            heatShape.setFillColor(sf::Color(55 + 200 * heat, 64, 255 - 200 * heat));
+            heatShape.setPosition(4.f, subViewHeight / NB_OPCODES_ROWS * rowId + 8.f);
+            texture.draw(heatShape);
+        }
+    }
     
-    texture->draw(text);
+    texture.draw(m_opcodesText);
     
-    texture->display();
+    texture.display();
     return texture;
     
 }
 
-std::unique_ptr<sf::RenderTexture> Chip8::displayMemory() {
+sf::RenderTexture & Chip8::displayMemory(Snapshot const& state) {
     float subViewWidth = m_screenWidth * 0.4f;
     float subViewHeight = m_screenHeigth * 0.7f;
     
-    auto texture {std::make_unique<sf::RenderTexture>()};
-    texture->create(subViewWidth, subViewHeight);
-    texture->clear(sf::Color(38, 52, 82));
-    
-    const float characterSize = 28.f;
+    auto & texture {preparePanel(m_memoryPanel, subViewWidth, subViewHeight, sf::Color(38, 52, 82))};
     
     std::stringstream stream;
     
     for (int registerId = 0; registerId < 11; ++registerId) {
         stream << "V" << std::hex << registerId << " = #";
-        if (m_registers[registerId] < 16) {
+        if (state.registers[registerId] < 16) {
             stream << "0";
         }
-        stream << static_cast<int>(m_registers[registerId]) << "    ";
+        stream << static_cast<int>(state.registers[registerId]) << "    ";
         
         int value = -1;
         int zeroRefValue = -1;
         
         if (registerId < 4) {
             stream << "V" << std::hex << registerId + 11 << " = #";
-            if (m_registers[registerId + 11] < 16) {
+            if (state.registers[registerId + 11] < 16) {
                 stream << "0";
             }
-            stream << static_cast<int>(m_registers[registerId]) << "\n";
+            stream << static_cast<int>(state.registers[registerId]) << "\n";
             continue;
         } else if (registerId == 5) {
             stream << "GC";
-            value = m_gameCounter;
+            value = state.gameCounter;
             zeroRefValue = 16;
         } else if (registerId == 6) {
             stream << "SC";
-            value = m_soundCounter;
+            value = state.soundCounter;
             zeroRefValue = 16;
         } else if (registerId == 8) {
             stream << "I ";
-            value = m_registerAdress;
+            value = state.registerAdress;
             zeroRefValue = 4096;
         } else if (registerId == 9) {
             stream << "PC";
-            value = m_programCounter;
+            value = state.programCounter;
             zeroRefValue = 4096;
         } else if (registerId == 10) {
             stream << "SL";
-            value = m_stackLevel;
+            value = state.stackLevel;
             zeroRefValue = 16;
         }
         
@@ -871,27 +1553,88 @@ std::unique_ptr<sf::RenderTexture> Chip8::displayMemory() {
         stream << "\n";
     }
         
-    sf::Text text;
-    text.setFont(m_defaultFont);
-    text.setCharacterSize(characterSize);
-    text.setFillColor(sf::Color::White);
-    text.setPosition(10.f, 7.f);
-    text.setString(stream.str());
-    text.setLineSpacing((1.8f - (m_screenHeigth <= 700 ? 0.1f : 0.f)) * m_screenHeigth / 800.f);
+    m_memoryText.setString(stream.str());
+    texture.draw(m_memoryText);
+    
+    texture.display();
+    return texture;
+}
+
+sf::RenderTexture & Chip8::displayHexViewer(Snapshot const& state) {
+    float subViewWidth = m_hexViewerWidth;
+    float subViewHeight = m_windowHeight;
+    
+    auto & texture {preparePanel(m_hexViewerPanel, subViewWidth, subViewHeight, sf::Color(33, 45, 71))};
+    
+    static constexpr char hexDigits[] = "0123456789ABCDEF";
+    static constexpr std::size_t rowSize = 4 + 1 + NB_HEX_BYTES_PER_ROW * 3 + 1 + NB_HEX_BYTES_PER_ROW + 1;
+    
+    std::size_t const pageSize = NB_HEX_ROWS * NB_HEX_BYTES_PER_ROW;
+    std::size_t const begin = std::min(m_hexViewerBegining, state.memory.size() > pageSize ? state.memory.size() - pageSize : 0);
+    
+    std::string content(NB_HEX_ROWS * rowSize, ' ');
+    for (std::size_t rowId = 0; rowId < NB_HEX_ROWS; ++rowId) {
+        char * row = &content[rowId * rowSize];
+        row[rowSize - 1] = '\n';
+        
+        std::size_t const rowAdress = begin + rowId * NB_HEX_BYTES_PER_ROW;
+        if (rowAdress >= state.memory.size())
+            continue;
+        
+        for (int digitId = 0; digitId < 4; ++digitId)
+            row[digitId] = hexDigits[(rowAdress >> (12 - digitId * 4)) & 0xF];
+        
+        for (std::size_t byteId = 0; byteId < NB_HEX_BYTES_PER_ROW && rowAdress + byteId < state.memory.size(); ++byteId) {
+            std::uint8_t const value = state.memory[rowAdress + byteId];
+            row[5 + byteId * 3] = hexDigits[value >> 4];
+            row[6 + byteId * 3] = hexDigits[value & 0xF];
+            row[6 + NB_HEX_BYTES_PER_ROW * 3 + byteId] = (value >= ' ' && value <= '~') ? static_cast<char>(value) : '.';
+        }
+    }
+    m_hexViewerText.setString(content);
+    
+    auto const cellSize {m_hexViewerFont.getCellSize()};
+    auto const textPosition {m_hexViewerText.getPosition()};
+    
+    auto const highlight = [&](std::size_t adress, sf::Color const& color) {
+        if (adress < begin || adress >= begin + pageSize)
+            return;
+        std::size_t const rowId = (adress - begin) / NB_HEX_BYTES_PER_ROW;
+        std::size_t const byteId = (adress - begin) % NB_HEX_BYTES_PER_ROW;
+        
+        sf::RectangleShape shape {{cellSize.x * 2, cellSize.y}};
+        shape.setFillColor(color);
+        shape.setPosition(textPosition.x + (5 + byteId * 3) * cellSize.x, textPosition.y + rowId * cellSize.y);
+        texture.draw(shape);
+    };
+    
+    // Older writes are drawn first and fainter so that recent ones stay on top
+    std::size_t const nbRecentWrites = std::min(state.nbWrites, NB_RECENT_WRITES);
+    for (std::size_t age = nbRecentWrites; age > 0; --age) {
+        std::size_t const writeId = (state.nbWrites - age) % NB_RECENT_WRITES;
+        highlight(state.recentWrites[writeId], sf::Color(255, 128, 0, 255 - (age - 1) * 200 / NB_RECENT_WRITES));
+    }
+    highlight(state.registerAdress, sf::Color(200, 0, 0));
     
-    texture->draw(text);
+    texture.draw(m_hexViewerText);
     
-    texture->display();
+    texture.display();
     return texture;
 }
 
-std::unique_ptr<sf::RenderTexture> Chip8::displayDebugInfos() {
+void Chip8::scrollHexViewer(int nbRows) {
+    std::size_t const pageSize = NB_HEX_ROWS * NB_HEX_BYTES_PER_ROW;
+    std::size_t const lastBegining = m_memorySize > pageSize ? m_memorySize - pageSize : 0;
+    
+    long long const begin = static_cast<long long>(m_hexViewerBegining) + static_cast<long long>(nbRows) * NB_HEX_BYTES_PER_ROW;
+    m_hexViewerBegining = std::min<std::size_t>(std::max(begin, 0ll), lastBegining);
+}
+
+sf::RenderTexture & Chip8::displayDebugInfos(Frame const& frame) {
     float subViewWidth = m_screenWidth;
     float subViewHeight = m_screenHeigth * 0.7f;
     
-    auto texture {std::make_unique<sf::RenderTexture>()};
-    texture->create(subViewWidth, subViewHeight);
-    texture->clear(sf::Color(59, 81, 128));
+    auto & texture {preparePanel(m_debugInfosPanel, subViewWidth, subViewHeight, sf::Color(59, 81, 128))};
     
     std::ostringstream stream;
     
@@ -904,77 +1647,256 @@ std::unique_ptr<sf::RenderTexture> Chip8::displayDebugInfos() {
     
     stream << "\n";
     
-    stream << "fps: " << (m_isPaused ? m_fps : std::round(1.f / m_displayTimer.getElapsedTime().asSeconds())) << "\n";
+    stream << "fps: " << std::round(m_displayScheduler.getMeasuredFps()) << "\n";
+    if (!frame.breakReason.empty())
+        stream << "Paused on " << frame.breakReason << "\n";
+    if (frame.isCoverageEnabled)
+        stream << "Coverage: " << frame.nbVisited << " adresses executed\n";
+    if (m_runAheadFrames > 0)
+        stream << "Run-ahead: " << m_runAheadFrames << " frames (" << frame.runAheadCost << " ms)\n";
     
     stream << "\n\n";
     
     stream << "Pause  : " << ExtendedInputs::getKeyName(m_controlKeys[16]) << "\n";
     stream << "Reload : " << ExtendedInputs::getKeyName(m_controlKeys[17]) << "\n";
     stream << "Jump   : " << ExtendedInputs::getKeyName(m_controlKeys[18]) << "\n";
+    stream << "Back   : " << ExtendedInputs::getKeyName(m_controlKeys[24]) << "\n";
+    if (m_tracer.isEnabled())
+        stream << "Trace  : " << ExtendedInputs::getKeyName(m_controlKeys[23]) << "\n";
+    if (m_showHexViewer) {
+        stream << "Memory : " << ExtendedInputs::getKeyName(m_controlKeys[19]) << " " << ExtendedInputs::getKeyName(m_controlKeys[20]);
+        stream << " " << ExtendedInputs::getKeyName(m_controlKeys[21]) << " " << ExtendedInputs::getKeyName(m_controlKeys[22]) << "\n";
+    }
     
-    sf::Text text(stream.str(), m_defaultFont);
-    text.setCharacterSize(25);
-    text.setLineSpacing(1.1f * m_screenHeigth / 800.f);
-    text.setFillColor(sf::Color::White);
-    text.setPosition(20.f, 0.f);
-    
-    texture->draw(text);
+    m_debugInfosText.setString(stream.str());
+    texture.draw(m_debugInfosText);
     
-    texture->display();
+    texture.display();
     return texture;
 }
 
 std::uint16_t Chip8::getOpcodeAt(std::uint16_t adress) {
-    return ((m_memory[adress] << 8) + m_memory[adress + 1]);
+    return m_memory.fetch(adress);
 }
 
 std::uint16_t Chip8::getCurrentOpcode() {
     return getOpcodeAt(m_programCounter);
 }
 
-std::uint8_t Chip8::getActionFromOpcode(std::uint16_t opcode) {
-    for (int i = 0; i < m_opcodeIdentifiers.size(); ++i) {
-        auto const& id {m_opcodeIdentifiers[i]};
-        if (id.identifier == (id.mask & opcode))
-            return i;
-    }
-    return 0;
+Chip8::DecodedInstruction Chip8::decodeInstruction(std::uint16_t opcode) const {
+    DecodedInstruction instruction;
+    instruction.action = &m_actions[decodeOpcode(opcode)];
+    instruction.b3 = (opcode & 0x0F00) >> 8;
+    instruction.b2 = (opcode & 0x00F0) >> 4;
+    instruction.b1 = opcode & 0x000F;
+    return instruction;
 }
 
-void Chip8::computeAction(std::uint8_t actionId, std::uint16_t opcode) {
-    std::uint8_t b3,b2,b1;
-    
-    b3 = (opcode&(0x0F00)) >> 8;
-    b2 = (opcode&(0x00F0)) >> 4;
-    b1 = (opcode&(0x000F));
-    
-    if (actionId >= NB_OPCODES_AVAILABLES)
-        throw std::runtime_error("Action id " + std::to_string(actionId) + " could not be recognised neither handled");
+Chip8::DecodedInstruction const& Chip8::getCurrentInstruction() {
+    if (static_cast<std::size_t>(m_programCounter) + 1 >= m_decodedInstructions.size()) {
+        m_uncachedInstruction = decodeInstruction(getCurrentOpcode());
+        return m_uncachedInstruction;
+    }
     
-    m_actions[actionId](b1, b2, b3);
+    auto & instruction {m_decodedInstructions[m_programCounter]};
+    if (!instruction.action)
+        instruction = decodeInstruction(getCurrentOpcode());
+    return instruction;
+}
+
+void Chip8::invalidateDecodedInstructions(std::uint32_t adress) {
+    if (m_decodedInstructions.empty())
+        return;
+    
+    // Byte is the first one of the instruction at its adress and the second one of the instruction before
+    adress %= m_decodedInstructions.size();
+    m_decodedInstructions[adress].action = nullptr;
+    if (adress > 0)
+        m_decodedInstructions[adress - 1].action = nullptr;
+}
+
+void Chip8::predecodeInstructions() {
+    for (auto const& block : m_controlFlowGraph.getBlocks()) {
+        for (std::size_t adress = block.begin; adress < block.end && adress + 1 < m_decodedInstructions.size(); ++adress) {
+            if (m_controlFlowGraph.getByteKind(adress) == ControlFlowGraph::ByteKind::Instruction)
+                m_decodedInstructions[adress] = decodeInstruction(getOpcodeAt(static_cast<std::uint16_t>(adress)));
+        }
+    }
+}
+
+void Chip8::saveSnapshot(Snapshot & snapshot) const {
+    snapshot.memory = m_memory.getData();
+    snapshot.stack = m_stack;
+    snapshot.registers = m_registers;
+    snapshot.keyPressed = m_keyPressed;
+    snapshot.pixels = m_pixels;
+    snapshot.selectedPlanes = m_selectedPlanes;
+    snapshot.audioPattern = m_audioPattern;
+    snapshot.audioPitch = m_audioPitch;
+    snapshot.hasAudioPattern = m_hasAudioPattern;
+    snapshot.rplFlags = m_rplFlags;
+    snapshot.programCounter = m_programCounter;
+    snapshot.stackLevel = m_stackLevel;
+    snapshot.registerAdress = m_registerAdress;
+    snapshot.gameCounter = m_gameCounter;
+    snapshot.soundCounter = m_soundCounter;
+    snapshot.cycle = m_cycle;
+    snapshot.randomGenerator = m_randomGenerator;
+    snapshot.recentWrites = m_recentWrites;
+    snapshot.nbWrites = m_nbWrites;
+}
+
+void Chip8::restoreSnapshot(Snapshot const& snapshot) {
+    auto const& memory {m_memory.getData()};
+    if (memory.size() != m_decodedInstructions.size() || snapshot.memory.size() != memory.size()) {
+        m_decodedInstructions.assign(snapshot.memory.size(), {});
+    } else {
+        // Only instructions whose bytes differ are decoded again, so that run ahead keeps its cache between frames
+        for (std::size_t adress = 0; adress < memory.size(); ++adress) {
+            if (memory[adress] != snapshot.memory[adress])
+                invalidateDecodedInstructions(static_cast<std::uint32_t>(adress));
+        }
+    }
+    m_memory.setData(snapshot.memory);
+    m_stack = snapshot.stack;
+    m_registers = snapshot.registers;
+    m_keyPressed = snapshot.keyPressed;
+    m_pixels = snapshot.pixels;
+    m_selectedPlanes = snapshot.selectedPlanes;
+    m_isAudioPatternDirty = m_isAudioPatternDirty || m_audioPattern != snapshot.audioPattern || m_audioPitch != snapshot.audioPitch;
+    m_audioPattern = snapshot.audioPattern;
+    m_audioPitch = snapshot.audioPitch;
+    m_hasAudioPattern = snapshot.hasAudioPattern;
+    m_rplFlags = snapshot.rplFlags;
+    m_programCounter = snapshot.programCounter;
+    m_stackLevel = snapshot.stackLevel;
+    m_registerAdress = snapshot.registerAdress;
+    m_gameCounter = snapshot.gameCounter;
+    m_soundCounter = snapshot.soundCounter;
+    m_cycle = snapshot.cycle;
+    m_randomGenerator = snapshot.randomGenerator;
+    m_recentWrites = snapshot.recentWrites;
+    m_nbWrites = snapshot.nbWrites;
+}
+
+void Chip8::writeMemory(std::uint32_t adress, std::uint8_t value) {
+    m_memory.write(adress, value);
+    m_recentWrites[m_nbWrites++ % NB_RECENT_WRITES] = static_cast<std::uint16_t>(adress);
+    invalidateDecodedInstructions(adress);
 }
 
 void Chip8::clearScreen() {
-    std::fill(m_pixels.begin(), m_pixels.end(), false);
+    forEachSelectedPlane([](Framebuffer & plane) {
+        plane.clear();
+    });
 }
 
+template <bool IsClipped, bool CountsRows>
 void Chip8::drawSprite(std::uint8_t b1, std::uint8_t b2, std::uint8_t b3) {
     m_registers[0xF] = 0;
     
-    for (int dY = 0; dY < b1; ++dY) {
-        const std::uint8_t rowDescription = m_memory[m_registerAdress + dY];
-        const int y = (m_registers[b2] + dY) % m_height;
-        for (int bitId = 0; bitId < 8; ++bitId) {
-            bool pixelOn = rowDescription & (0x1 << (7 - bitId));
-            if (!pixelOn)
-                continue;
-            const int x = (m_registers[b3] + bitId) % m_width;
-            if (m_pixels[y * m_width + x]) {
+    bool const isLarge = b1 == 0;
+    std::size_t const nbRows = isLarge ? 16 : b1;
+    std::size_t const width = m_pixels[0].getWidth();
+    std::size_t const height = m_pixels[0].getHeight();
+    std::size_t const x = m_registers[b3] % width;
+    std::size_t const y = m_registers[b2] % height;
+    bool const isRowCount = CountsRows && width > m_width; // SCHIP 1.1 only counts rows in high resolution
+    std::uint8_t nbHitRows = 0;
+    
+    // Each selected plane uses the sprite following the one of the previous plane
+    std::uint32_t adress = m_registerAdress;
+    forEachSelectedPlane([&](Framebuffer & plane) {
+        std::uint32_t const spriteEnd = adress + nbRows * (isLarge ? 2 : 1);
+        for (std::size_t dY = 0; dY < nbRows; ++dY) {
+            if constexpr (IsClipped) {
+                if (y + dY >= height) {
+                    nbHitRows += static_cast<std::uint8_t>(nbRows - dY);
+                    break;
+                }
+            }
+            
+            std::uint16_t rowDescription;
+            if (isLarge) {
+                rowDescription = (m_memory.read(adress) << 8) | m_memory.read(adress + 1);
+                adress += 2;
+            } else {
+                rowDescription = m_memory.read(adress++);
+            }
+            
+            if (plane.drawRow<IsClipped>(x, (y + dY) % height, rowDescription, isLarge ? 16 : 8)) {
                 m_registers[0xF] = 1;
+                ++nbHitRows;
             }
-            m_pixels[y * m_width + x] = !m_pixels[y * m_width + x];
         }
+        adress = spriteEnd;
+    });
+    
+    if (isRowCount)
+        m_registers[0xF] = nbHitRows;
+}
+
+void Chip8::setHighResolution(bool isHighResolution) {
+    std::size_t const scale = isHighResolution ? 2 : 1;
+    for (auto & plane : m_pixels)
+        plane.resize(m_width * scale, m_height * scale);
+}
+
+void Chip8::skipNextInstruction() {
+    m_programCounter += getOpcodeAt(m_programCounter + 2) == 0xF000 ? 4 : 2;
+}
+
+void Chip8::playAudioPattern() {
+    if (m_isAudioPatternDirty) {
+        std::array<sf::Int16, 128> samples;
+        for (std::size_t sampleId = 0; sampleId < samples.size(); ++sampleId)
+            samples[sampleId] = (m_audioPattern[sampleId / 8] >> (7 - sampleId % 8)) & 0x1 ? 8000 : -8000;
+        
+        auto const sampleRate {4000.f * std::pow(2.f, (m_audioPitch - 64) / 48.f)};
+        
+        auto & audio {getAudio()};
+        audio.patternSound.stop(); // Buffer must not be used while it is updated
+        audio.patternBuffer.loadFromSamples(samples.data(), samples.size(), 1, static_cast<unsigned int>(sampleRate));
+        audio.patternSound.setBuffer(audio.patternBuffer);
+        audio.patternSound.setLoop(true);
+        m_isAudioPatternDirty = false;
     }
+    
+    if (getAudio().patternSound.getStatus() != sf::Sound::Playing)
+        getAudio().patternSound.play();
+}
+
+void Chip8::playDefaultSound() {
+    auto & audio {getAudio()};
+    if (!m_isDefaultSoundLoaded) {
+        m_isDefaultSoundLoaded = true;
+        if (!audio.defaultSound.openFromFile(m_soundFilename))
+            std::cout << "Error: could not load sound from file " << m_soundFilename << std::endl;
+    }
+    
+    audio.defaultSound.stop();
+    audio.defaultSound.play();
+}
+
+Chip8::Audio & Chip8::getAudio() {
+    if (!m_audio)
+        m_audio = std::make_unique<Audio>();
+    return *m_audio;
+}
+
+bool Chip8::loadPalette(std::string const& palette) {
+    std::stringstream stream(palette);
+    std::string color;
+    
+    for (auto & paletteColor : m_palette) {
+        if (!std::getline(stream, color, ',') || color.size() != 6 || !std::all_of(color.begin(), color.end(), [](unsigned char c) { return std::isxdigit(c) != 0; }))
+            return false;
+        
+        auto const rgb {std::stoul(color, nullptr, 16)};
+        paletteColor = sf::Color((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF);
+    }
+    
+    return true;
 }
 
 }
@@ -16,8 +16,16 @@
 # include <memory>
 # include <fstream>
 # include <limits>
+# include <cctype>
 # include <cmath>
+# include <random>
+# include <atomic>
+# include <thread>
+# include <exception>
+# include <filesystem>
+# include <utility>
 
+# include <stdio.h>
 # include <stdlib.h>
 # include <time.h>
 
@@ -26,6 +34,23 @@
 
 # include "ExternalLibrairies/TSL/hopscotch_map.h"
 
+# include "BitmapText.hpp"
+# include "ControlFlowGraph.hpp"
+# include "Coverage.hpp"
+# include "Debugger.hpp"
+# include "Framebuffer.hpp"
+# include "FrameScheduler.hpp"
+# include "MemoryBus.hpp"
+# include "Opcodes.hpp"
+# include "Quirks.hpp"
+# include "RomBrowser.hpp"
+# include "RomDatabase.hpp"
+# include "Screenshot.hpp"
+# include "SpscQueue.hpp"
+# include "StartupProfile.hpp"
+# include "Tracer.hpp"
+# include "TripleBuffer.hpp"
+# include "VideoRecorder.hpp"
 # include "Parser.hpp"
 # include "InputNames.hpp"
 
@@ -43,9 +68,10 @@ public:
     Chip8() = default;
     
     /**
-     \brief Default destructor
+     \brief Destructor
+     \details Stops emulation thread if needed
      */
-    ~Chip8() = default;
+    ~Chip8();
     
     /**
      \brief Deleted move constructor
@@ -66,10 +92,125 @@ public:
      \brief Launches emulator
      \details The emulator emulates a chip8 environment and provides additional infos. All the configuration deatils must be provided in the configuration file provided
      \param configFilename String storing the path of the configuration file where to find the configuration parameters
+     \param isStartupProfiled True to print how long each startup step took once the first frame is displayed
      */
-    void launch(std::string const& configFilename);
+    void launch(std::string const& configFilename, bool isStartupProfiled = false);
+    
+    /**
+     \brief Decodes execution trace dumped by emulator
+     \details Writes one line per instruction with its cycle, adress, opcode, mnemonic and the registers after execution
+     \param traceFilename String storing the path of the trace file
+     \param output Stream where to write the decoded trace
+     \return False if trace file could not be read
+     */
+    bool decodeTrace(std::string const& traceFilename, std::ostream & output);
+    
+    /**
+     \brief Decodes video recorded by emulator
+     \details Writes a PNG image of every frame that differs from the previous one, named after the number of the frame
+     \param videoFilename String storing the path of the video file
+     \param outputDirectory Directory where to write the images
+     \return False if video file could not be read or an image could not be written
+     */
+    bool decodeVideo(std::string const& videoFilename, std::string const& outputDirectory) const;
+    
+    /**
+     \brief Structure storing a keypad change of a headless run
+     */
+    struct KeyInput {
+        std::uint64_t cycle; // Instruction before which the change is applied
+        std::uint8_t keyId;
+        bool isPressed;
+    };
+    
+    /**
+     \brief Initialises emulator without window, sound nor fonts
+     \details Default configuration is used and random generator gets a fixed seed, so that two runs of the same game are identical
+     \param game Bytes of the game, copied at memory start and truncated if they do not fit in memory
+     \param quirks Interpreter quirks, combination of Quirk flags
+     \param memorySize Size of the memory in bytes, 65536 for XO-CHIP games. Throws if it is not greater than memory start.
+     */
+    void initHeadless(std::vector<std::uint8_t> const& game, std::uint8_t quirks = 0, std::size_t memorySize = 4096);
+    
+    /**
+     \brief Executes instructions without window
+     \details initHeadless must have been called before
+     \param nbCycles Number of instructions to execute
+     \param inputs Keypad changes sorted by cycle. Key ids greater than 15 are ignored.
+     */
+    void runHeadless(std::uint64_t nbCycles, std::vector<KeyInput> const& inputs);
+    
+    /**
+     \brief Writes emulated screen in an image file, at its native resolution
+     \details Pixels are read from the emulated planes and colored with the palette, so no window is needed
+     \param filename Path of the image, its extension (.png or .ppm) gives the format
+     \return False if format is unknown or file could not be written
+     */
+    bool saveScreenshot(std::string const& filename) const;
     
 private:
+    static constexpr std::size_t NB_RECENT_WRITES = 32;
+    
+# ifdef CHIP8_BOUNDS_CHECKS
+    static constexpr bool BOUNDS_CHECKS = true;
+# else
+    static constexpr bool BOUNDS_CHECKS = false;
+# endif
+    
+    static constexpr std::size_t NB_PLANES = 2; // XO-CHIP bitplanes
+    using Planes = std::array<Framebuffer, NB_PLANES>;
+    
+    /**
+     \brief Structure storing the whole emulated machine state
+     */
+    struct Snapshot {
+        std::vector<std::uint8_t> memory;
+        std::vector<std::uint16_t> stack;
+        std::array<std::uint8_t, 16> registers;
+        std::array<bool, 16> keyPressed;
+        Planes pixels;
+        std::uint8_t selectedPlanes;
+        std::array<std::uint8_t, 16> rplFlags;
+        std::array<std::uint8_t, 16> audioPattern;
+        std::uint8_t audioPitch;
+        bool hasAudioPattern;
+        std::uint16_t programCounter;
+        std::uint8_t stackLevel;
+        std::uint16_t registerAdress;
+        std::uint8_t gameCounter;
+        std::uint8_t soundCounter;
+        std::uint64_t cycle;
+        std::minstd_rand randomGenerator;
+        std::array<std::uint16_t, NB_RECENT_WRITES> recentWrites; // Ring of the last memory adresses written
+        std::size_t nbWrites;
+    };
+    
+    /**
+     \brief Structure storing what emulation thread publishes for display
+     \details Only the parts of the state read by display are filled: memory only while opcodes or hex viewer are shown, stack and random generator never. Screen pixels of the state are the run-ahead ones when run-ahead is enabled.
+     */
+    struct Frame {
+        Snapshot state;
+        std::uint64_t memoryGeneration = 0; // Memory generation copied in state, so that unchanged memory is not copied again
+        float runAheadCost = 0.f; // ms
+        bool isPaused = false;
+        std::string breakReason;
+        bool isCoverageEnabled = false;
+        std::vector<std::uint32_t> executionCounts; // Counts of the adresses the opcodes panel can show, empty if it is hidden
+        std::size_t executionCountsBegin = 0; // Adress of the first count
+        std::size_t nbVisited = 0;
+    };
+    
+    /**
+     \brief Structure storing a keypad change
+     */
+    struct InputEvent {
+        std::uint8_t keyId;
+        bool isPressed;
+        FrameScheduler::Clock::time_point timestamp; // When the key was handled by display thread
+        std::uint64_t cycle; // Instruction before which the change was applied, set by emulation thread
+    };
+    
     /**
      \brief Initialises emulator
      \details Loads configuration and resources. Setups Chip8 system.
@@ -77,6 +218,12 @@ private:
      */
     void init(std::string const& configFilename);
     
+    /**
+     \brief Resets Chip8 system and debugging state
+     \details Memory must already be loaded with font and game
+     */
+    void reset();
+    
     /**
      \brief Loads configuration stored in file specified
      \param configFilename String storing the path of the configuration file where to find the configuration parameters
@@ -88,24 +235,59 @@ private:
      */
     void loadFont();
     
+    /**
+     \brief Rasterizes font specified in config file into the bitmap fonts used by debug panels
+     */
+    void loadTextFonts();
+    
     /**
      \brief Loads game file
-     \details Loads in Chip8 memory the content of game file specified
+     \details Loads in Chip8 memory the content of game file specified and computes its hash
      \param fileName String storing the path of game file
      */
     bool loadFile(std::string fileName);
     
+    /**
+     \brief Applies settings of the loaded game found in ROM database
+     \details Settings of the profile replace the ones of the configuration file
+     */
+    void applyRomProfile();
+    
+    /**
+     \brief Replaces running game without reloading configuration and resources
+     \details Window, textures, fonts and sounds are kept, only the machine state is reset
+     \param offset Position of the new game in games directory relatively to the current one
+     */
+    void switchGame(int offset);
     
     /**
-     \brief Loads all Chip8 opcodes and stores them in a structure
+     \brief Resets machine and loads given game in memory
+     \details Settings of the configuration file are restored before applying the profile of the game
+     \param game Game content
      */
-    void loadOpcodes();
+    void loadGame(std::vector<std::uint8_t> const& game);
+    
     
     /**
      \brief Loads actions associted to all Chip8 opcodes and stores them in a structure
      */
     void loadActions();
     
+    /**
+     \brief Loads actions of the opcodes affected by quirks
+     \details Quirks are resolved once here, so that actions do not check them on every instruction
+     \param quirks Combination of Quirk values
+     */
+    template <std::size_t... QuirksCombinations>
+    void loadQuirksActions(std::uint8_t quirks, std::index_sequence<QuirksCombinations...>);
+    
+    /**
+     \brief Loads actions of the opcodes affected by quirks for a given policy
+     \tparam QuirksPolicy Instantiation of Quirks
+     */
+    template <typename QuirksPolicy>
+    void loadQuirksActions();
+    
     
     /**
      \brief Loads input keys from configuration file
@@ -121,42 +303,190 @@ private:
     void handleKey(sf::Keyboard::Key key, bool keyPressed);
     
     
+    /**
+     \brief Starts emulation thread
+     \details The first frame is published before the thread starts so that display always has a frame to show
+     */
+    void startEmulation();
+    /**
+     \brief Stops emulation thread and waits for it to end
+     */
+    void stopEmulation();
+    /**
+     \brief Emulation thread loop
+     \details Executes instructions at "update_frequency" and publishes a frame for display at "framerate", independently from display thread
+     */
+    void emulate();
+    /**
+     \brief Applies on emulated keypad the inputs queued by display thread until given instruction time
+     \details A key release is delayed to the next instruction if its press was applied at the same instruction, so that no press is ever lost. Applied inputs are stamped with current cycle and logged.
+     \param instructionTime Time at which the next instruction is scheduled
+     */
+    void applyInputs(FrameScheduler::Clock::time_point instructionTime);
+    /**
+     \brief Publishes current machine state to display thread
+     \details Copies only what shown panels read, so that debug panels do not slow down emulation thread when they are hidden
+     */
+    void publishFrame();
+    
+    
     /**
      \brief Updates emulator (update frequency is specified in configuration file as "update_frequency")
      */
     void update();
     
     
+    /**
+     \brief Updates emulator, records trace and checks breakpoints and watchpoints
+     \details Instrumented version of update, only used while debugger is armed or tracing is enabled. Emulation is paused if a breakpoint or watchpoint is hit.
+     \return False if emulation was paused
+     */
+    bool updateInstrumented();
+    /**
+     \brief Checks if instrumented version of update must be used
+     \return True if a breakpoint is set, tracing or coverage is enabled
+     */
+    bool isInstrumented() const;
+    /**
+     \brief Writes execution trace in file specified as "trace_file" in configuration file
+     */
+    void dumpTrace();
+    /**
+     \brief Pauses emulation on the access trapped by memory bus
+     \details Must only be called if memory bus has trapped
+     */
+    void takeMemoryTrap();
+    /**
+     \brief Hooks memory adresses watched by debugger on memory bus
+     */
+    void setWatchpointHooks();
+    
+    
+    /**
+     \brief Saves a rewind snapshot if enough instructions were executed since the last one
+     \details Once the ring is full, logged inputs older than the oldest snapshot are dropped
+     */
+    void recordRewindSnapshot();
+    /**
+     \brief Steps back to the previous instruction
+     \details Restores the nearest rewind snapshot and re-executes instructions until the previous one, with the recorded inputs
+     */
+    void stepBack();
+    /**
+     \brief Re-executes instructions until given cycle with the recorded inputs
+     \param cycle Cycle to reach
+     */
+    void replayUntil(std::uint64_t cycle);
+    
+    
+    /**
+     \brief Emulates frames ahead of current state to reduce input latency
+     \details Machine state is saved, "run_ahead" frames are emulated with current inputs, the resulting screen is kept for display, and machine state is restored
+     */
+    void runAhead();
+    
+    
+    /**
+     \brief Clears a persistent panel texture, creating it only if its size changed
+     \param texture Texture kept between frames, so that panels do not allocate a texture every frame
+     \param width Width of the panel
+     \param height Height of the panel
+     \param color Background color of the panel
+     \return The texture, ready to be drawn in
+     */
+    static sf::RenderTexture & preparePanel(sf::RenderTexture & texture, float width, float height, sf::Color const& color);
     /**
      \brief Displays emulator window
-     \return Ptr on texture storing the emulator window texture
+     \param frame Frame published by emulation thread to display
+     \return Texture storing the emulator window texture
      */
-    std::unique_ptr<sf::RenderTexture> display();
+    sf::RenderTexture & display(Frame const& frame);
     /**
      \brief Displays Chip8 emulator screen
-     \return Ptr on texture storing the Chip8 emulator pixels
+     \param state Machine state to display
+     \return Texture storing the Chip8 emulator pixels
      */
-    std::unique_ptr<sf::RenderTexture> displayScreen();
+    sf::RenderTexture & displayScreen(Snapshot const& state);
+    /**
+     \brief Calls function on every pixel which is on in at least one plane
+     \param planes Planes to read
+     \param function Function called with the column, the row and the palette index of the pixel
+     */
+    template <typename Function>
+    static void forEachColoredPixel(Planes const& planes, Function && function);
+    /**
+     \brief Writes given planes in an image file, at their native resolution
+     \param planes Planes to write
+     \param filename Path of the image, its extension (.png or .ppm) gives the format
+     \return False if format is unknown or file could not be written
+     */
+    bool saveScreenshot(Planes const& planes, std::string const& filename) const;
+    /**
+     \brief Starts recording displayed frames in file specified as "video_file" in configuration file
+     */
+    void startVideoRecording();
+    /**
+     \brief Stops recording displayed frames and waits for the end of their encoding
+     */
+    void stopVideoRecording();
+    /**
+     \brief Queues planes to be encoded in the video, without waiting for the encoding
+     \param planes Planes displayed
+     */
+    void recordVideoFrame(Planes const& planes);
     /**
      \brief Displays opcodes debugging window
-     \details Display is only made if parameter "show_opcodes" is set true in configuration file
-     \return Ptr on texture storing the debugging window
+     \details Display is only made if parameter "show_opcodes" is set true in configuration file. If coverage is enabled, a heatmap of execution counts is drawn on the left of the opcodes.
+     \param frame Frame published by emulation thread to display
+     \return Texture storing the debugging window
      */
-    std::unique_ptr<sf::RenderTexture> displayOpcodes();
+    sf::RenderTexture & displayOpcodes(Frame const& frame);
+    /**
+     \brief Disassembles opcode located at given adress
+     \details Lines are cached per adress and rebuilt only if the opcode in memory (or I for opcodes using it) changed since last call. Bytes of the game that the control flow graph found to be data are shown as DB, unless the program counter is on them.
+     \param state Machine state where to read the opcode
+     \param adress Adress of the opcode to disassemble
+     \return The disassembled line
+     */
+    std::string const& disassemble(Snapshot const& state, std::uint16_t adress);
     /**
     \brief Displays memory debugging window
     \details Display is only made if parameter "show_memory" is set true in configuration file
-    \return Ptr on texture storing the debugging window
+    \param state Machine state to display
+    \return Texture storing the debugging window
     */
-    std::unique_ptr<sf::RenderTexture> displayMemory();
+    sf::RenderTexture & displayMemory(Snapshot const& state);
+    /**
+    \brief Displays hexadecimal viewer of the whole memory
+    \details Display is only made if parameter "show_hex_viewer" is set true in configuration file. Only visible rows are formatted so display cost does not depend on memory size.
+    \param state Machine state to display
+    \return Texture storing the viewer window
+    */
+    sf::RenderTexture & displayHexViewer(Snapshot const& state);
+    /**
+    \brief Scrolls hexadecimal viewer
+    \param nbRows Number of rows to scroll, negative to scroll up
+    */
+    void scrollHexViewer(int nbRows);
     /**
     \brief Displays debug infos window
     \details Display is only made if parameter "show_infos" is set true in configuration file
-    \return Ptr on texture storing the infos window
+    \param frame Frame published by emulation thread to display
+    \return Texture storing the infos window
     */
-    std::unique_ptr<sf::RenderTexture> displayDebugInfos();
+    sf::RenderTexture & displayDebugInfos(Frame const& frame);
     
     
+    /**
+     \brief Opcode split in its action and operands
+     */
+    struct DecodedInstruction {
+        std::function<void(std::uint8_t b1, std::uint8_t b2, std::uint8_t b3)> const* action = nullptr; // nullptr if not decoded yet
+        std::uint8_t b1 = 0;
+        std::uint8_t b2 = 0;
+        std::uint8_t b3 = 0;
+    };
+    
     /**
      \brief Gets opcode located at given position in memory
      \param adress Adress of the opcode to get
@@ -169,17 +499,54 @@ private:
      */
     std::uint16_t getCurrentOpcode();
     /**
-     \brief Action id associated to the given opcode
-     \param opcode The opcode to get the related action
-     \return The id of the action
+     \brief Decodes opcode in its action and operands
+     \param opcode Opcode to decode
+     \return The decoded instruction
+     */
+    DecodedInstruction decodeInstruction(std::uint16_t opcode) const;
+    /**
+     \brief Gets decoded instruction located at program counter position in memory
+     \details Instructions are predecoded when the game is loaded or decoded on their first execution, and kept until one of their bytes is written, so that steady state execution does not fetch nor decode opcodes
+     \return The decoded instruction
+     */
+    DecodedInstruction const& getCurrentInstruction();
+    /**
+     \brief Forgets decoded instructions using the byte at given adress
+     \param adress Adress written, wrapped like memory writes
+     */
+    void invalidateDecodedInstructions(std::uint32_t adress);
+    /**
+     \brief Decodes every instruction found by the control flow graph of the game
+     \details Instructions not found, for example after a BNNN jump or in code written by the game, are still decoded on their first execution
+     */
+    void predecodeInstructions();
+    
+    
+    /**
+     \brief Writes value in memory and records the write for display
+     \param adress Adress where to write
+     \param value Value to write
      */
-    std::uint8_t getActionFromOpcode(std::uint16_t opcode);
+    void writeMemory(std::uint32_t adress, std::uint8_t value);
+    
     /**
-     \brief Computes action of given id with given opcode as parameter
-     \param actionId Id of action to compute
-     \param opcode Opcode to use as parameter for given action
+     \brief Accesses element of a container, checking index if CHIP8_BOUNDS_CHECKS is defined
+     \details Out of bounds accesses abort so that fuzzers and sanitizers report them with a stack trace. Without CHIP8_BOUNDS_CHECKS, this is a plain [] access.
+     \param container Container to access
+     \param index Index of the element
+     \param name Name of the container, printed on failure
+     \return Reference on the element
      */
-    void computeAction(std::uint8_t actionId, std::uint16_t opcode);
+    template <typename Container>
+    static decltype(auto) checkedAccess(Container & container, std::size_t index, char const* name) {
+        if constexpr (BOUNDS_CHECKS) {
+            if (index >= container.size()) {
+                std::cerr << "Error: out of bounds access " << name << "[" << index << "], size is " << container.size() << std::endl;
+                std::abort();
+            }
+        }
+        return container[index];
+    }
     
     
     /**
@@ -188,21 +555,104 @@ private:
     void clearScreen();
     /**
      \brief Draws sprite in Chip8 screen according to paramters given
+     \details If b1 is 0, sprite is 16x16 (SCHIP DXY0), else it is 8 pixels wide and b1 rows high
+     \tparam IsClipped True to clip sprite at screen edges instead of wrapping it around
+     \tparam CountsRows True to set VF to the number of rows colliding or clipped in high resolution instead of 1 on collision
      \param b1 Four least significant bits
      \param b2 Four middle bits
      \param b3 Four strong bits
      */
+    template <bool IsClipped, bool CountsRows>
     void drawSprite(std::uint8_t b1, std::uint8_t b2, std::uint8_t b3);
+    /**
+     \brief Calls function on every plane selected by FN01
+     \param function Function taking a Framebuffer reference
+     */
+    template <typename Function>
+    void forEachSelectedPlane(Function function) {
+        for (std::size_t planeId = 0; planeId < NB_PLANES; ++planeId) {
+            if (m_selectedPlanes & (0x1 << planeId))
+                function(m_pixels[planeId]);
+        }
+    }
+    /**
+     \brief Switches between low (width_resolution x height_resolution) and high (twice larger) resolution
+     \details All planes are cleared
+     \param isHighResolution True for SCHIP high resolution
+     */
+    void setHighResolution(bool isHighResolution);
+    /**
+     \brief Skips next instruction, which is 4 bytes long if it is XO-CHIP F000 NNNN
+     */
+    void skipNextInstruction();
+    /**
+     \brief Plays XO-CHIP audio pattern in loop, rebuilding its samples if pattern or pitch changed
+     */
+    void playAudioPattern();
+    /**
+     \brief Plays default sound from its begining
+     \details Sound file is opened on first use
+     */
+    void playDefaultSound();
+    
+    struct Audio;
+    /**
+     \brief Gets audio resources
+     \details Audio device is opened on first call, so that games which never play sound do not wait for it
+     \return The audio resources
+     */
+    Audio & getAudio();
+    /**
+     \brief Loads colors of the pixels according to the planes they are set in
+     \param palette Four hexadecimal RGB colors separated with commas, for no plane, plane 1, plane 2 and both planes
+     \return False if palette could not be parsed
+     */
+    bool loadPalette(std::string const& palette);
+    
+    
+    /**
+     \brief Saves machine state in given snapshot
+     \details Snapshot buffers are reused so saving in the same snapshot again does not allocate
+     \param snapshot Snapshot where to store machine state
+     */
+    void saveSnapshot(Snapshot & snapshot) const;
+    /**
+     \brief Restores machine state from given snapshot
+     \param snapshot Snapshot storing the machine state to restore
+     */
+    void restoreSnapshot(Snapshot const& snapshot);
     
 private:
-    static constexpr std::size_t NB_OPCODES_AVAILABLES = 35;
-    static constexpr std::size_t NB_CONTROLS_AVAILABLES = 19;
+    static constexpr std::size_t NB_OPCODES_AVAILABLES = OPCODES.size();
+    static constexpr std::size_t SMALL_FONT_ADRESS = 0;
+    static constexpr std::size_t BIG_FONT_ADRESS = 80;
+    static constexpr std::size_t NB_CONTROLS_AVAILABLES = 29;
+    static inline const std::array<std::string, NB_CONTROLS_AVAILABLES> CONTROL_NAMES {"key_1", "key_2", "key_3", "key_4", "key_5", "key_6", "key_7", "key_8", "key_9", "key_A", "key_0", "key_B", "key_C", "key_D", "key_E", "key_F", "pause_key", "reload_key", "jump_key", "hex_up_key", "hex_down_key", "hex_page_up_key", "hex_page_down_key", "trace_key", "back_key", "previous_game_key", "next_game_key", "screenshot_key", "record_key"};
+    static constexpr std::size_t NB_OPCODES_ROWS = 19;
+    static constexpr unsigned int MEMORY_CHARACTER_SIZE = 28;
+    static constexpr unsigned int DEBUG_INFOS_CHARACTER_SIZE = 25;
+    static constexpr std::size_t NB_HEX_ROWS = 32;
+    static constexpr std::size_t NB_HEX_BYTES_PER_ROW = 8;
+    static constexpr std::size_t NB_REWIND_SNAPSHOTS = 64;
+    static constexpr std::uint64_t REWIND_INTERVAL = 1024; // Instructions between two rewind snapshots
     
     std::string m_configFilename;
     std::string m_gameFilename = "Games/Games/PONG.ch8";
     std::string m_soundFilename = "Resources/Sounds/sfx_sounds_high2.wav";
     std::string m_fontFilename = "Resources/Fonts/ArcadeClassic/ARCADECLASSIC.TTF";
     
+    RomDatabase m_romDatabase; // Kept between reloads, so that its file is read once
+    std::string m_romDatabaseFilename = "none";
+    std::uint64_t m_gameHash = 0;
+    
+    RomBrowser m_romBrowser;
+    std::string m_gamesDirectory = "none";
+    
+    // Settings of the configuration file, restored when a game without profile is loaded
+    std::uint8_t m_configQuirks = 0;
+    int m_configFrequency = 250;
+    std::array<sf::Keyboard::Key, NB_CONTROLS_AVAILABLES> m_configControlKeys;
+    
     std::size_t m_memorySize = 4096;
     std::size_t m_memoryBegin = 512;
     std::size_t m_maxStackSize = 15;
@@ -216,8 +666,9 @@ private:
     
     int m_fps = 60;
     int m_frequency = 250; // Hz
+    bool m_verticalSync = false;
     
-    std::vector<std::uint8_t> m_memory;
+    MemoryBus m_memory;
     std::vector<std::uint16_t> m_stack;
     
     std::array<std::uint8_t, 16> m_registers;
@@ -225,7 +676,16 @@ private:
     std::array<sf::Keyboard::Key, NB_CONTROLS_AVAILABLES> m_controlKeys;
     std::array<bool, 16> m_keyPressed;
     
-    std::vector<bool> m_pixels;
+    Planes m_pixels; // Width and height are doubled in high resolution mode
+    std::uint8_t m_selectedPlanes; // Bit i set if plane i is drawn by XO-CHIP instructions
+    std::array<sf::Color, 1 << NB_PLANES> m_palette {sf::Color::Black, sf::Color::White, sf::Color(255, 170, 0), sf::Color(170, 85, 0)};
+    std::array<std::uint8_t, 16> m_rplFlags; // SCHIP user flags saved by FX75
+    std::uint8_t m_quirks = 0; // Combination of Quirk values
+    
+    std::array<std::uint8_t, 16> m_audioPattern; // XO-CHIP 128 one bit samples
+    std::uint8_t m_audioPitch;
+    bool m_hasAudioPattern; // Default sound is played until a pattern is loaded
+    bool m_isAudioPatternDirty;
     
     std::uint16_t m_programCounter;
     std::uint8_t m_stackLevel;
@@ -234,30 +694,115 @@ private:
     std::uint8_t m_gameCounter;
     std::uint8_t m_soundCounter;
     
-    bool m_isPaused = false;
-    bool m_doSingleJump = false;
+    std::uint64_t m_cycle;
+    
+    std::minstd_rand m_randomGenerator;
+    
+    std::array<std::uint16_t, NB_RECENT_WRITES> m_recentWrites;
+    std::size_t m_nbWrites;
+    
+    std::atomic<bool> m_isPaused {false};
+    std::atomic<bool> m_doSingleJump {false};
+    std::atomic<bool> m_doStepBack {false};
+    
+    std::array<Snapshot, NB_REWIND_SNAPSHOTS> m_rewindSnapshots;
+    std::size_t m_nbRewindSnapshots;
+    std::uint64_t m_lastRewindCycle;
+    
+    std::size_t m_runAheadFrames = 0;
+    bool m_isSoundMuted = false;
+    float m_runAheadCost = 0.f; // ms
+    Snapshot m_runAheadSnapshot;
+    Planes m_runAheadPixels;
+    
+    Debugger m_debugger;
+    std::string m_breakReason;
+    
+    Tracer m_tracer;
+    std::string m_traceFilename = "trace.c8t";
+    std::atomic<bool> m_doDumpTrace {false};
+    
+    ControlFlowGraph m_controlFlowGraph; // Code and data of the game, found when it is loaded
+    
+    Coverage m_coverage;
+    bool m_isCoverageEnabled = false;
+    std::string m_coverageFilename = "coverage.csv";
+    
+    std::string m_screenshotFilename = "screenshot.png";
+    
+    VideoRecorder m_videoRecorder;
+    std::string m_videoFilename = "session.c8v";
+    bool m_isVideoRecorded = false; // Recording starts with the emulator
+    
+    std::thread m_emulationThread;
+    std::atomic<bool> m_isEmulationRunning {false};
+    std::atomic<bool> m_hasEmulationFailed {false};
+    std::exception_ptr m_emulationError;
+    
+    TripleBuffer<Frame> m_frames;
+    
+    SpscQueue<InputEvent, 256> m_inputQueue;
+    std::vector<InputEvent> m_inputLog;
     
     bool m_showDebugInfos = false;
     bool m_showOpcodes = false;
     bool m_showMemory = false;
+    bool m_showHexViewer = false;
     
     std::uint16_t m_opcodesDisplayBegining;
     
-    struct OpcodeIdentifier {
-        std::string opcode;
-        std::uint16_t mask;
-        std::uint16_t identifier;
-        std::string mnemonic;
+    struct DisassemblyLine {
+        std::uint16_t opcode = 0;
+        std::uint16_t registerAdress = 0;
+        bool usesRegisterAdress = false;
+        bool isData = false;
+        bool isValid = false;
+        std::string text;
     };
-    std::array<OpcodeIdentifier, NB_OPCODES_AVAILABLES> m_opcodeIdentifiers;
+    std::vector<DisassemblyLine> m_disassemblyCache;
+    BitmapText m_opcodesText;
+    bool m_isOpcodesTextValid = false;
     
-    std::array<std::function<void(std::uint8_t b1, std::uint8_t b2, std::uint8_t b3)>, NB_OPCODES_AVAILABLES> m_actions;
+    std::size_t m_hexViewerBegining;
+    float m_hexViewerWidth;
     
-    sf::Music m_defaultSound;
-    sf::Font m_defaultFont;
+    std::array<std::function<void(std::uint8_t b1, std::uint8_t b2, std::uint8_t b3)>, NB_OPCODES_AVAILABLES> m_actions;
+    std::vector<DecodedInstruction> m_decodedInstructions; // Indexed by adress
+    DecodedInstruction m_uncachedInstruction; // Instruction overlapping the end of memory, which is never cached
     
-    sf::Clock m_executionTimer;
-    sf::Clock m_displayTimer;
+    struct Audio {
+        sf::Music defaultSound;
+        sf::SoundBuffer patternBuffer;
+        sf::Sound patternSound;
+    };
+    std::unique_ptr<Audio> m_audio; // Created on first sound
+    bool m_isDefaultSoundLoaded = false;
+    
+    sf::Font m_defaultFont; // Loaded only if a debug panel is shown
+    
+    StartupProfile m_startupProfile;
+    
+    sf::Image m_screenImage;
+    sf::Texture m_screenTexture;
+    
+    // Render textures of the window and its panels, kept between frames and created again only when their size changes
+    sf::RenderTexture m_windowTexture;
+    sf::RenderTexture m_screenPanel;
+    sf::RenderTexture m_opcodesPanel;
+    sf::RenderTexture m_memoryPanel;
+    sf::RenderTexture m_hexViewerPanel;
+    sf::RenderTexture m_debugInfosPanel;
+    
+    BitmapFont m_opcodesFont;
+    BitmapFont m_memoryFont;
+    BitmapFont m_debugInfosFont;
+    BitmapFont m_hexViewerFont;
+    BitmapText m_memoryText;
+    BitmapText m_debugInfosText;
+    BitmapText m_hexViewerText;
+    
+    FrameScheduler m_scheduler;
+    FrameScheduler m_displayScheduler;
     
 };
 
@@ -0,0 +1,309 @@
+//
+//  ControlFlowGraph.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef ControlFlowGraph_hpp
+#define ControlFlowGraph_hpp
+
+# include <algorithm>
+# include <cstdint>
+# include <string_view>
+# include <vector>
+
+# include "Opcodes.hpp"
+
+namespace chp {
+
+/**
+ \brief Class to find the code of a game before running it
+ \details Instructions are followed from the entry point: jumps, calls, both branches of skips and returns. BNNN depends on V0, so only its first target is followed and the block is flagged as indirect. Bytes never reached are considered as data.
+ */
+class ControlFlowGraph {
+public:
+    /**
+     \brief Role of a byte of the game
+     */
+    enum class ByteKind : std::uint8_t {
+        Data,
+        Instruction, // First byte of an instruction
+        Operand // Other bytes of an instruction
+    };
+
+    /**
+     \brief Strongest reference to an adress, ordered by priority
+     */
+    enum class Target : std::uint8_t {
+        None,
+        Data, // Loaded in I
+        Jump,
+        Call,
+        Entry
+    };
+
+    /**
+     \brief Instructions always executed in sequence
+     */
+    struct Block {
+        std::uint16_t begin;
+        std::uint16_t end; // Adress following the last instruction
+        std::vector<std::uint16_t> successors; // Blocks of the game that can be executed next
+        bool isIndirect = false; // Ends with BNNN, whose targets are not all known
+        bool isReturn = false; // Ends with 00EE or 00FD
+    };
+
+    /**
+     \brief Default constructor, creates an empty graph
+     */
+    ControlFlowGraph() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~ControlFlowGraph() = default;
+
+
+    /**
+     \brief Analyzes a game
+     \param game Game content
+     \param size Size of the game
+     \param baseAdress Adress where the game is loaded, which is its entry point
+     */
+    void analyze(std::uint8_t const* game, std::size_t size, std::size_t baseAdress) {
+        m_game.assign(game, game + size);
+        m_baseAdress = baseAdress;
+        m_bytes.assign(size, ByteKind::Data);
+        m_targets.assign(size, Target::None);
+        m_blocks.clear();
+        m_nbCodeBytes = 0;
+
+        followInstructions();
+        buildBlocks();
+    }
+
+    /**
+     \brief Checks if adress is part of the analyzed game
+     */
+    bool contains(std::size_t adress) const {
+        return adress >= m_baseAdress && adress - m_baseAdress < m_bytes.size();
+    }
+
+    /**
+     \brief Gets role of the byte at given adress
+     \return The kind of byte, Data outside of the game
+     */
+    ByteKind getByteKind(std::size_t adress) const {
+        return contains(adress) ? m_bytes[adress - m_baseAdress] : ByteKind::Data;
+    }
+
+    /**
+     \brief Checks if byte at given adress was reached from the entry point
+     */
+    bool isCode(std::size_t adress) const {
+        return getByteKind(adress) != ByteKind::Data;
+    }
+
+    /**
+     \brief Gets strongest reference to given adress
+     \return The kind of reference, None outside of the game
+     */
+    Target getTarget(std::size_t adress) const {
+        return contains(adress) ? m_targets[adress - m_baseAdress] : Target::None;
+    }
+
+    /**
+     \brief Gets blocks of instructions
+     \return The blocks, sorted by adress
+     */
+    std::vector<Block> const& getBlocks() const {
+        return m_blocks;
+    }
+
+    /**
+     \brief Gets number of bytes that are instructions
+     */
+    std::size_t getNbCodeBytes() const {
+        return m_nbCodeBytes;
+    }
+
+    /**
+     \brief Checks if some code may only be reached through BNNN
+     \return True if a block ends with BNNN
+     */
+    bool hasIndirectJumps() const {
+        return std::any_of(m_blocks.begin(), m_blocks.end(), [](Block const& block) {
+            return block.isIndirect;
+        });
+    }
+
+private:
+    std::uint16_t getOpcode(std::size_t offset) const {
+        return (m_game[offset] << 8) | m_game[offset + 1];
+    }
+
+    // XO-CHIP LD I, LONG is followed by its adress
+    std::size_t getInstructionSize(std::size_t offset) const {
+        return OPCODES[decodeOpcode(getOpcode(offset))].pattern == "F000" ? 4 : 2;
+    }
+
+    static bool isSkip(std::string_view pattern) {
+        return pattern == "3XNN" || pattern == "4XNN" || pattern == "5XY0" || pattern == "9XY0" || pattern == "EX9E" || pattern == "EXA1";
+    }
+
+    /**
+     \brief Marks target of an instruction
+     \param adress Adress targeted
+     \param target Kind of reference
+     \param pending Offsets to analyze, target is added to them if it is code
+     */
+    void addTarget(std::size_t adress, Target target, std::vector<std::size_t> & pending) {
+        if (!contains(adress))
+            return;
+
+        auto const offset {adress - m_baseAdress};
+        m_targets[offset] = std::max(m_targets[offset], target);
+        if (target != Target::Data)
+            pending.push_back(offset);
+    }
+
+    /**
+     \brief Checks if bytes can be decoded as an instruction
+     \details Bytes must be in the game and not be part of another instruction
+     */
+    bool isFree(std::size_t offset, std::size_t size) const {
+        if (offset + size > m_bytes.size())
+            return false;
+        return std::all_of(m_bytes.begin() + offset, m_bytes.begin() + offset + size, [](ByteKind kind) {
+            return kind == ByteKind::Data;
+        });
+    }
+
+    void followInstructions() {
+        std::vector<std::size_t> pending;
+        addTarget(m_baseAdress, Target::Entry, pending);
+
+        while (!pending.empty()) {
+            auto offset {pending.back()};
+            pending.pop_back();
+
+            // Follows instructions until the flow leaves, reaches known code or unknown opcodes
+            while (offset + 1 < m_bytes.size() && m_bytes[offset] == ByteKind::Data) {
+                auto const opcode {getOpcode(offset)};
+                auto const actionId {decodeOpcode(opcode)};
+                auto const size {getInstructionSize(offset)};
+                if (actionId == 0 || !isFree(offset, size))
+                    break;
+
+                m_bytes[offset] = ByteKind::Instruction;
+                std::fill(m_bytes.begin() + offset + 1, m_bytes.begin() + offset + size, ByteKind::Operand);
+                m_nbCodeBytes += size;
+
+                auto const pattern {OPCODES[actionId].pattern};
+                std::size_t const adress = opcode & 0x0FFF;
+
+                if (pattern == "1NNN" || pattern == "BNNN") {
+                    addTarget(adress, Target::Jump, pending);
+                    break;
+                } else if (pattern == "2NNN") {
+                    addTarget(adress, Target::Call, pending);
+                } else if (pattern == "ANNN") {
+                    addTarget(adress, Target::Data, pending);
+                } else if (pattern == "F000") {
+                    addTarget(getOpcode(offset + 2), Target::Data, pending);
+                } else if (pattern == "00EE" || pattern == "00FD") {
+                    break;
+                } else if (isSkip(pattern)) {
+                    // Skipped instruction is followed by the loop, the instruction after it is another branch
+                    auto const next {offset + size};
+                    if (next + 1 < m_bytes.size())
+                        pending.push_back(next + getInstructionSize(next));
+                }
+
+                offset += size;
+            }
+        }
+    }
+
+    /**
+     \brief Splits instructions in blocks
+     \details A block begins at every target, after every skip or call and after data, and ends before the next block or with a branch
+     */
+    void buildBlocks() {
+        std::vector<bool> isLeader(m_bytes.size(), false);
+        for (std::size_t offset = 0; offset < m_bytes.size(); ++offset) {
+            if (m_bytes[offset] != ByteKind::Instruction)
+                continue;
+            if (m_targets[offset] >= Target::Jump)
+                isLeader[offset] = true;
+
+            auto const pattern {OPCODES[decodeOpcode(getOpcode(offset))].pattern};
+            auto const next {offset + getInstructionSize(offset)};
+            if (next < m_bytes.size() && (pattern == "2NNN" || isSkip(pattern))) {
+                isLeader[next] = true;
+                if (isSkip(pattern) && m_bytes[next] == ByteKind::Instruction && next + getInstructionSize(next) < m_bytes.size())
+                    isLeader[next + getInstructionSize(next)] = true;
+            }
+        }
+
+        for (std::size_t offset = 0; offset < m_bytes.size();) {
+            if (m_bytes[offset] != ByteKind::Instruction) {
+                ++offset;
+                continue;
+            }
+
+            Block block;
+            block.begin = static_cast<std::uint16_t>(m_baseAdress + offset);
+
+            std::uint16_t opcode;
+            std::string_view pattern;
+            do {
+                opcode = getOpcode(offset);
+                pattern = OPCODES[decodeOpcode(opcode)].pattern;
+                offset += getInstructionSize(offset);
+            } while (offset < m_bytes.size() && m_bytes[offset] == ByteKind::Instruction && !isLeader[offset] && !isBranch(pattern));
+            block.end = static_cast<std::uint16_t>(m_baseAdress + offset);
+
+            std::uint16_t const adress = opcode & 0x0FFF;
+            if (pattern == "1NNN" || pattern == "BNNN") {
+                addSuccessor(block, adress);
+                block.isIndirect = pattern == "BNNN";
+            } else if (pattern == "00EE" || pattern == "00FD") {
+                block.isReturn = true;
+            } else if (pattern == "2NNN") {
+                addSuccessor(block, adress);
+                addSuccessor(block, block.end);
+            } else if (isSkip(pattern)) {
+                addSuccessor(block, block.end);
+                if (contains(block.end) && m_bytes[block.end - m_baseAdress] == ByteKind::Instruction)
+                    addSuccessor(block, block.end + getInstructionSize(block.end - m_baseAdress));
+            } else {
+                addSuccessor(block, block.end);
+            }
+
+            m_blocks.push_back(std::move(block));
+        }
+    }
+
+    static bool isBranch(std::string_view pattern) {
+        return pattern == "1NNN" || pattern == "BNNN" || pattern == "2NNN" || pattern == "00EE" || pattern == "00FD" || isSkip(pattern);
+    }
+
+    void addSuccessor(Block & block, std::size_t adress) const {
+        if (contains(adress) && m_bytes[adress - m_baseAdress] == ByteKind::Instruction)
+            block.successors.push_back(static_cast<std::uint16_t>(adress));
+    }
+
+private:
+    std::vector<std::uint8_t> m_game;
+    std::size_t m_baseAdress = 0;
+    std::vector<ByteKind> m_bytes;
+    std::vector<Target> m_targets;
+    std::vector<Block> m_blocks;
+    std::size_t m_nbCodeBytes = 0;
+};
+
+}
+
+#endif /* ControlFlowGraph_hpp */
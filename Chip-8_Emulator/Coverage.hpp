@@ -0,0 +1,124 @@
+//
+//  Coverage.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Coverage_hpp
+#define Coverage_hpp
+
+# include <cstdint>
+# include <fstream>
+# include <limits>
+# include <string>
+# include <vector>
+
+namespace chp {
+
+/**
+ \brief Class to count instructions executed at each memory adress
+ \details Keeps a saturating 32 bits counter per adress and a bitmap of the adresses visited at least once
+ */
+class Coverage {
+public:
+    /**
+     \brief Default constructor
+     */
+    Coverage() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~Coverage() = default;
+
+
+    /**
+     \brief Enables or disables coverage and clears counters
+     \param isEnabled True to count executed instructions
+     \param memorySize Number of adresses to cover
+     */
+    void reset(bool isEnabled, std::size_t memorySize) {
+        m_counts.assign(isEnabled ? memorySize : 0, 0);
+        m_visited.assign(isEnabled ? (memorySize + 63) / 64 : 0, 0);
+        m_nbVisited = 0;
+    }
+
+    /**
+     \brief Checks if coverage is enabled
+     \return True if executed instructions must be recorded
+     */
+    bool isEnabled() const {
+        return !m_counts.empty();
+    }
+
+    /**
+     \brief Records instruction executed at given adress
+     \param adress Adress of the instruction executed
+     */
+    void record(std::uint16_t adress) {
+        if (adress >= m_counts.size())
+            return;
+
+        auto & count {m_counts[adress]};
+        if (count == 0) {
+            m_visited[adress / 64] |= std::uint64_t(1) << (adress % 64);
+            ++m_nbVisited;
+        }
+        if (count != std::numeric_limits<std::uint32_t>::max())
+            ++count;
+    }
+
+    /**
+     \brief Gets execution counters
+     \return Counters indexed by adress
+     */
+    std::vector<std::uint32_t> const& getCounts() const {
+        return m_counts;
+    }
+
+    /**
+     \brief Gets visited adresses bitmap
+     \return Bitmap where bit adress % 64 of word adress / 64 is set if adress was executed
+     */
+    std::vector<std::uint64_t> const& getVisited() const {
+        return m_visited;
+    }
+
+    /**
+     \brief Gets number of adresses executed at least once
+     \return The number of adresses visited
+     */
+    std::size_t getNbVisited() const {
+        return m_nbVisited;
+    }
+
+    /**
+     \brief Writes counters of visited adresses in text file
+     \details File has one "<adress>,<count>" row per visited adress, adress being hexadecimal
+     \param filename Path of the file to write
+     \return True if file could be written
+     */
+    bool dump(std::string const& filename) const {
+        std::ofstream file(filename);
+        if (!file.is_open())
+            return false;
+
+        file << "adress,count\n";
+        for (std::size_t adress = 0; adress < m_counts.size(); ++adress) {
+            if (m_counts[adress] > 0)
+                file << std::hex << adress << "," << std::dec << m_counts[adress] << "\n";
+        }
+
+        return file.good();
+    }
+
+private:
+    std::vector<std::uint32_t> m_counts;
+    std::vector<std::uint64_t> m_visited;
+    std::size_t m_nbVisited = 0;
+};
+
+}
+
+#endif /* Coverage_hpp */
@@ -0,0 +1,312 @@
+//
+//  Debugger.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Debugger_hpp
+#define Debugger_hpp
+
+# include <algorithm>
+# include <array>
+# include <cctype>
+# include <cstdint>
+# include <iostream>
+# include <optional>
+# include <sstream>
+# include <string>
+# include <utility>
+# include <vector>
+
+# include "ExternalLibrairies/TSL/hopscotch_set.h"
+
+namespace chp {
+
+/**
+ \brief Class to store breakpoints and watchpoints and check them against machine state
+ \details Breakpoints are checked by the instrumented execution path, which the emulator uses only while a breakpoint is set. Watchpoints are checked by memory bus hooks.
+ */
+class Debugger {
+public:
+    /**
+     \brief Structure describing memory accessed by an instruction
+     \details Range is [begin, end[, empty if begin equals end
+     */
+    struct MemoryAccess {
+        std::uint32_t begin = 0;
+        std::uint32_t end = 0;
+        bool isWrite = false;
+    };
+
+    /**
+     \brief Default constructor
+     */
+    Debugger() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~Debugger() = default;
+
+
+    /**
+     \brief Loads breakpoints and watchpoints from their configuration strings
+     \details Breakpoints are separated with commas and written <adress> or <adress>@V<register><comparison><value>, where adress can be * to break anywhere and comparison is one of == != < >. Watchpoints are separated with commas and written <r|w|rw><adress> or <r|w|rw><first adress>-<last adress>. All values are hexadecimal. "none" sets nothing. Invalid entries are ignored.
+     \param breakpoints String storing breakpoints
+     \param watchpoints String storing watchpoints
+     */
+    void load(std::string const& breakpoints, std::string const& watchpoints) {
+        m_breakpoints.clear();
+        m_conditionalBreakpoints.clear();
+        m_watchpoints.clear();
+
+        for (auto const& entry : split(breakpoints)) {
+            if (!parseBreakpoint(entry))
+                std::cout << "Error: could not parse breakpoint " << entry << std::endl;
+        }
+        for (auto const& entry : split(watchpoints)) {
+            if (!parseWatchpoint(entry))
+                std::cout << "Error: could not parse watchpoint " << entry << std::endl;
+        }
+    }
+
+    /**
+     \brief Checks if any breakpoint is set
+     \return True if emulator must use the instrumented execution path
+     */
+    bool hasBreakpoints() const {
+        return !m_breakpoints.empty() || !m_conditionalBreakpoints.empty();
+    }
+
+    /**
+     \brief Gets adresses watched
+     \return First and last adresses of each watchpoint
+     */
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> getWatchedRanges() const {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> ranges;
+        for (auto const& watchpoint : m_watchpoints)
+            ranges.emplace_back(watchpoint.first, watchpoint.last);
+        return ranges;
+    }
+
+    /**
+     \brief Checks breakpoints after an instruction was executed
+     \param programCounter Adress of the next instruction
+     \param registers Registers after the instruction
+     \return Description of the breakpoint hit, std::nullopt if none was hit
+     */
+    std::optional<std::string> check(std::uint16_t programCounter, std::array<std::uint8_t, 16> const& registers) const {
+        if (m_breakpoints.contains(programCounter))
+            return "breakpoint " + toHex(programCounter);
+
+        for (auto const& breakpoint : m_conditionalBreakpoints) {
+            if (breakpoint.adress && *breakpoint.adress != programCounter)
+                continue;
+            if (breakpoint.condition.isVerified(registers))
+                return "breakpoint " + (breakpoint.adress ? toHex(*breakpoint.adress) : std::string("*")) + " V" + toHex(breakpoint.condition.registerId);
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     \brief Checks watchpoints on a memory access
+     \param access Memory accessed by an instruction
+     \return Description of the watchpoint hit, std::nullopt if none was hit
+     */
+    std::optional<std::string> checkAccess(MemoryAccess const& access) const {
+        if (access.begin == access.end)
+            return std::nullopt;
+
+        for (auto const& watchpoint : m_watchpoints) {
+            if ((access.isWrite ? watchpoint.onWrite : watchpoint.onRead) && access.begin <= watchpoint.last && watchpoint.first < access.end)
+                return std::string(access.isWrite ? "write" : "read") + " watchpoint " + toHex(watchpoint.first);
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    enum class Comparison {
+        Equal,
+        NotEqual,
+        Less,
+        Greater
+    };
+
+    struct Condition {
+        std::uint8_t registerId;
+        Comparison comparison;
+        std::uint8_t value;
+
+        bool isVerified(std::array<std::uint8_t, 16> const& registers) const {
+            auto const registerValue {registers[registerId]};
+            switch (comparison) {
+                case Comparison::Equal:
+                    return registerValue == value;
+                case Comparison::NotEqual:
+                    return registerValue != value;
+                case Comparison::Less:
+                    return registerValue < value;
+                case Comparison::Greater:
+                    return registerValue > value;
+            }
+            return false;
+        }
+    };
+
+    struct ConditionalBreakpoint {
+        std::optional<std::uint16_t> adress; // std::nullopt to check condition at every adress
+        Condition condition;
+    };
+
+    struct Watchpoint {
+        std::uint32_t first;
+        std::uint32_t last;
+        bool onRead;
+        bool onWrite;
+    };
+
+    /**
+     \brief Splits configuration string on commas
+     \param string String to split
+     \return Non empty entries, nothing if string is "none"
+     */
+    static std::vector<std::string> split(std::string const& string) {
+        std::vector<std::string> entries;
+        if (string == "none")
+            return entries;
+
+        std::stringstream stream(string);
+        std::string entry;
+        while (std::getline(stream, entry, ',')) {
+            if (!entry.empty())
+                entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    /**
+     \brief Parses hexadecimal value
+     \param string String to parse, entirely
+     \return The value parsed, std::nullopt if string is not hexadecimal
+     */
+    static std::optional<std::uint32_t> parseHex(std::string const& string) {
+        if (string.empty() || string.size() > 8)
+            return std::nullopt;
+
+        std::size_t parsed = 0;
+        auto const value {std::stoul(string, &parsed, 16)};
+        if (parsed != string.size())
+            return std::nullopt;
+        return static_cast<std::uint32_t>(value);
+    }
+
+    // Takes an unsigned char, so that non ASCII characters are not passed as negative values
+    static bool isHexDigit(unsigned char c) {
+        return std::isxdigit(c) != 0;
+    }
+
+    static std::string toHex(std::uint32_t value) {
+        std::ostringstream stream;
+        stream << std::hex << value;
+        return stream.str();
+    }
+
+    bool parseBreakpoint(std::string const& entry) {
+        auto const conditionPos {entry.find('@')};
+        auto const adressString {entry.substr(0, conditionPos)};
+
+        std::optional<std::uint16_t> adress;
+        if (adressString != "*") {
+            if (!std::all_of(adressString.begin(), adressString.end(), isHexDigit))
+                return false;
+            auto const value {parseHex(adressString)};
+            if (!value || *value > 0xFFFF)
+                return false;
+            adress = static_cast<std::uint16_t>(*value);
+        }
+
+        if (conditionPos == std::string::npos) {
+            if (!adress)
+                return false;
+            m_breakpoints.insert(*adress);
+            return true;
+        }
+
+        // Condition is V<register><comparison><value>
+        auto const condition {entry.substr(conditionPos + 1)};
+        if (condition.size() < 4 || (condition[0] != 'V' && condition[0] != 'v') || !isHexDigit(condition[1]))
+            return false;
+
+        ConditionalBreakpoint breakpoint;
+        breakpoint.adress = adress;
+        breakpoint.condition.registerId = static_cast<std::uint8_t>(std::stoul(condition.substr(1, 1), nullptr, 16));
+
+        std::size_t valuePos = 4;
+        auto const comparison {condition.substr(2, 2)};
+        if (comparison == "==") {
+            breakpoint.condition.comparison = Comparison::Equal;
+        } else if (comparison == "!=") {
+            breakpoint.condition.comparison = Comparison::NotEqual;
+        } else if (condition[2] == '<') {
+            breakpoint.condition.comparison = Comparison::Less;
+            valuePos = 3;
+        } else if (condition[2] == '>') {
+            breakpoint.condition.comparison = Comparison::Greater;
+            valuePos = 3;
+        } else {
+            return false;
+        }
+
+        auto const valueString {condition.substr(valuePos)};
+        if (!std::all_of(valueString.begin(), valueString.end(), isHexDigit))
+            return false;
+        auto const value {parseHex(valueString)};
+        if (!value || *value > 0xFF)
+            return false;
+        breakpoint.condition.value = static_cast<std::uint8_t>(*value);
+
+        m_conditionalBreakpoints.push_back(breakpoint);
+        return true;
+    }
+
+    bool parseWatchpoint(std::string const& entry) {
+        Watchpoint watchpoint {0, 0, false, false};
+
+        std::size_t pos = 0;
+        while (pos < entry.size() && (entry[pos] == 'r' || entry[pos] == 'w')) {
+            (entry[pos] == 'r' ? watchpoint.onRead : watchpoint.onWrite) = true;
+            ++pos;
+        }
+        if (!watchpoint.onRead && !watchpoint.onWrite)
+            return false;
+
+        auto const range {entry.substr(pos)};
+        auto const separatorPos {range.find('-')};
+        auto const first {range.substr(0, separatorPos)};
+        auto const last {separatorPos == std::string::npos ? first : range.substr(separatorPos + 1)};
+        if (!std::all_of(first.begin(), first.end(), isHexDigit) || !std::all_of(last.begin(), last.end(), isHexDigit))
+            return false;
+
+        auto const firstValue {parseHex(first)};
+        auto const lastValue {parseHex(last)};
+        if (!firstValue || !lastValue || *lastValue < *firstValue)
+            return false;
+
+        watchpoint.first = *firstValue;
+        watchpoint.last = *lastValue;
+        m_watchpoints.push_back(watchpoint);
+        return true;
+    }
+
+private:
+    tsl::hopscotch_set<std::uint16_t> m_breakpoints;
+    std::vector<ConditionalBreakpoint> m_conditionalBreakpoints;
+    std::vector<Watchpoint> m_watchpoints;
+};
+
+}
+
+#endif /* Debugger_hpp */
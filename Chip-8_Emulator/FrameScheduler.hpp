@@ -0,0 +1,169 @@
+//
+//  FrameScheduler.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef FrameScheduler_hpp
+#define FrameScheduler_hpp
+
+# include <algorithm>
+# include <chrono>
+# include <cstddef>
+# include <thread>
+
+namespace chp {
+
+/**
+ \brief Class to pace instructions execution and frames display
+ \details Deadlines are tracked on a monotonic clock and advanced by a fixed period so that no drift accumulates. The caller sleeps between short batches of instructions instead of busy-waiting, so that timers, inputs and sound are accurate within BATCH_PERIOD rather than within a frame. Instructions late on their deadline are executed in one batch to catch up, up to MAX_CATCH_UP.
+ */
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     \brief Default constructor
+     */
+    FrameScheduler() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~FrameScheduler() = default;
+
+    /**
+     \brief Resets all deadlines from current time
+     \param frequency Instructions execution frequency in Hz
+     \param fps Frames display frequency in Hz
+     */
+    void reset(int frequency, int fps) {
+        m_instructionPeriod = periodFromFrequency(frequency);
+        m_framePeriod = periodFromFrequency(fps);
+
+        auto const now {Clock::now()};
+        m_nextInstruction = now;
+        m_nextFrame = now;
+        m_lastFrame = now;
+        m_measuredFps = static_cast<float>(std::max(fps, 1));
+    }
+
+    /**
+     \brief Counts instructions whose deadline is reached and advances instructions deadline accordingly
+     \details If emulation is late by more than MAX_CATCH_UP, the late instructions are dropped and deadline is resynchronised on current time
+     \param now Current time
+     \return Number of instructions to execute now
+     */
+    std::size_t pendingInstructions(Clock::time_point now) {
+        if (now < m_nextInstruction)
+            return 0;
+
+        if (now - m_nextInstruction > MAX_CATCH_UP)
+            m_nextInstruction = now - MAX_CATCH_UP;
+
+        auto const count {static_cast<std::size_t>((now - m_nextInstruction) / m_instructionPeriod) + 1};
+        m_nextInstruction += m_instructionPeriod * count;
+        return count;
+    }
+
+    /**
+     \brief Drops every pending instruction
+     \details Used while emulation is paused so that resuming does not execute the instructions missed during pause
+     \param now Current time
+     */
+    void skipInstructions(Clock::time_point now) {
+        m_nextInstruction = now;
+    }
+
+    /**
+     \brief Checks if a frame must be displayed and advances frame deadline if so
+     \param now Current time
+     \param vsync True if display is synchronised on vertical sync. In this case every call is a new frame since display blocks until next refresh.
+     \return True if a frame must be displayed now
+     */
+    bool isFrameDue(Clock::time_point now, bool vsync) {
+        if (!vsync && now < m_nextFrame)
+            return false;
+
+        m_nextFrame += m_framePeriod;
+        if (m_nextFrame <= now)
+            m_nextFrame = now + m_framePeriod; // Missed frames are not caught up
+
+        auto const elapsed {std::chrono::duration<float>(now - m_lastFrame).count()};
+        if (elapsed > 0.f)
+            m_measuredFps += (1.f / elapsed - m_measuredFps) * FPS_SMOOTHING;
+        m_lastFrame = now;
+
+        return true;
+    }
+
+    /**
+     \brief Sleeps until next frame deadline
+     */
+    void waitNextFrame() const {
+        std::this_thread::sleep_until(m_nextFrame);
+    }
+
+    /**
+     \brief Sleeps until next batch of instructions or next frame deadline, whichever comes first
+     \details A batch covers BATCH_PERIOD of instructions, or a single instruction if instructions period is longer
+     \param isPaused True if instructions are not executed, only frame deadline is waited then
+     */
+    void waitNextDeadline(bool isPaused) const {
+        auto const nextBatch {m_nextInstruction + std::max(BATCH_PERIOD - m_instructionPeriod, Clock::duration::zero())};
+        std::this_thread::sleep_until(isPaused ? m_nextFrame : std::min(m_nextFrame, nextBatch));
+    }
+
+    /**
+     \brief Gets time at which the next instruction is scheduled
+     \return The next instruction deadline
+     */
+    Clock::time_point getInstructionDeadline() const {
+        return m_nextInstruction;
+    }
+
+    /**
+     \brief Gets time between two instructions
+     \return The instructions period
+     */
+    Clock::duration getInstructionPeriod() const {
+        return m_instructionPeriod;
+    }
+
+    /**
+     \brief Gets frame rate measured on last frames displayed
+     \return The smoothed frame rate measured
+     */
+    float getMeasuredFps() const {
+        return m_measuredFps;
+    }
+
+private:
+    /**
+     \brief Converts frequency in period
+     \param frequency Frequency in Hz
+     \return Period on clock duration
+     */
+    static Clock::duration periodFromFrequency(int frequency) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / std::max(frequency, 1)));
+    }
+
+private:
+    static constexpr Clock::duration BATCH_PERIOD = std::chrono::milliseconds(2);
+    static constexpr Clock::duration MAX_CATCH_UP = std::chrono::milliseconds(50); // Longer stalls are dropped rather than shown as a fast-forward
+    static constexpr float FPS_SMOOTHING = 0.1f;
+
+    Clock::duration m_instructionPeriod;
+    Clock::duration m_framePeriod;
+
+    Clock::time_point m_nextInstruction;
+    Clock::time_point m_nextFrame;
+    Clock::time_point m_lastFrame;
+
+    float m_measuredFps = 60.f;
+};
+
+}
+
+#endif /* FrameScheduler_hpp */
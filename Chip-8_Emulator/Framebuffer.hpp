@@ -0,0 +1,245 @@
+//
+//  Framebuffer.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Framebuffer_hpp
+#define Framebuffer_hpp
+
+# include <algorithm>
+# include <cstdint>
+# include <vector>
+
+namespace chp {
+
+/**
+ \brief Class to store a monochrome screen packed in 64 bits words
+ \details Each row starts on a new word. Pixel x of a row is bit 63 - x % 64 of word x / 64, so that horizontal scrolling is a shift of the row words. Bits after the last pixel of a row are always 0.
+ */
+class Framebuffer {
+public:
+    /**
+     \brief Default constructor, creates an empty framebuffer
+     */
+    Framebuffer() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~Framebuffer() = default;
+
+
+    /**
+     \brief Resizes screen and turns all pixels off
+     \param width Number of pixels per row
+     \param height Number of rows
+     */
+    void resize(std::size_t width, std::size_t height) {
+        m_width = width;
+        m_height = height;
+        m_wordsPerRow = (width + 63) / 64;
+        m_words.assign(m_wordsPerRow * height, 0);
+    }
+
+    /**
+     \brief Gets number of pixels per row
+     \return The screen width
+     */
+    std::size_t getWidth() const {
+        return m_width;
+    }
+
+    /**
+     \brief Gets number of rows
+     \return The screen height
+     */
+    std::size_t getHeight() const {
+        return m_height;
+    }
+
+    /**
+     \brief Checks if screen has no pixel
+     \return True if framebuffer was never resized
+     */
+    bool isEmpty() const {
+        return m_words.empty();
+    }
+
+    /**
+     \brief Gets packed pixels
+     \return Rows of getWordsPerRow() words each
+     */
+    std::vector<std::uint64_t> const& getWords() const {
+        return m_words;
+    }
+
+    /**
+     \brief Gets number of words used by each row
+     \return The row stride in words
+     */
+    std::size_t getWordsPerRow() const {
+        return m_wordsPerRow;
+    }
+
+    /**
+     \brief Gets pixel state
+     \param x Column of the pixel
+     \param y Row of the pixel
+     \return True if pixel is on
+     */
+    bool get(std::size_t x, std::size_t y) const {
+        return (m_words[y * m_wordsPerRow + x / 64] >> (63 - x % 64)) & 0x1;
+    }
+
+    /**
+     \brief Turns all pixels off
+     */
+    void clear() {
+        std::fill(m_words.begin(), m_words.end(), 0);
+    }
+
+    /**
+     \brief Xors a sprite row on screen
+     \details Pixels after the end of the row wrap around to its begining, or are not drawn if IsClipped is true
+     \tparam IsClipped True to discard pixels after the end of the row
+     \param x Column of the first pixel, must be lower than width
+     \param y Row, must be lower than height
+     \param bits Sprite row, the most significant of the nbBits least significant bits being the leftmost pixel
+     \param nbBits Number of pixels of the sprite row, 64 at most
+     \return True if a pixel was turned off
+     */
+    template <bool IsClipped = false>
+    bool drawRow(std::size_t x, std::size_t y, std::uint64_t bits, std::size_t nbBits) {
+        auto * const row {&m_words[y * m_wordsPerRow]};
+        std::uint64_t collisions = 0;
+
+        if constexpr (IsClipped) {
+            if (nbBits > m_width - x) {
+                bits >>= nbBits - (m_width - x);
+                nbBits = m_width - x;
+            }
+        }
+
+        while (nbBits > 0) {
+            // Part of the sprite drawn before wrapping around
+            std::size_t const nbPartBits = std::min(nbBits, m_width - x);
+            std::uint64_t const part = (bits >> (nbBits - nbPartBits)) << (64 - nbPartBits);
+
+            std::size_t const wordId = x / 64;
+            std::size_t const offset = x % 64;
+
+            std::uint64_t const high = part >> offset;
+            collisions |= row[wordId] & high;
+            row[wordId] ^= high;
+
+            if (offset + nbPartBits > 64) {
+                std::uint64_t const low = part << (64 - offset);
+                collisions |= row[wordId + 1] & low;
+                row[wordId + 1] ^= low;
+            }
+
+            nbBits -= nbPartBits;
+            bits &= nbBits < 64 ? (std::uint64_t(1) << nbBits) - 1 : ~std::uint64_t(0);
+            x = 0;
+        }
+
+        return collisions != 0;
+    }
+
+    /**
+     \brief Scrolls screen down, rows on top are turned off
+     \param nbRows Number of rows to scroll
+     */
+    void scrollDown(std::size_t nbRows) {
+        nbRows = std::min(nbRows, m_height);
+        std::copy_backward(m_words.begin(), m_words.end() - nbRows * m_wordsPerRow, m_words.end());
+        std::fill_n(m_words.begin(), nbRows * m_wordsPerRow, 0);
+    }
+
+    /**
+     \brief Scrolls screen up, rows at the bottom are turned off
+     \param nbRows Number of rows to scroll
+     */
+    void scrollUp(std::size_t nbRows) {
+        nbRows = std::min(nbRows, m_height);
+        std::copy(m_words.begin() + nbRows * m_wordsPerRow, m_words.end(), m_words.begin());
+        std::fill(m_words.end() - nbRows * m_wordsPerRow, m_words.end(), 0);
+    }
+
+    /**
+     \brief Scrolls screen right, leftmost columns are turned off
+     \param nbColumns Number of columns to scroll, lower than 64
+     */
+    void scrollRight(std::size_t nbColumns) {
+        if (nbColumns == 0)
+            return;
+
+        for (std::size_t rowBegin = 0; rowBegin < m_words.size(); rowBegin += m_wordsPerRow) {
+            for (std::size_t wordId = m_wordsPerRow; wordId-- > 0;) {
+                auto & word {m_words[rowBegin + wordId]};
+                word >>= nbColumns;
+                if (wordId > 0)
+                    word |= m_words[rowBegin + wordId - 1] << (64 - nbColumns);
+            }
+            m_words[rowBegin + m_wordsPerRow - 1] &= getLastWordMask();
+        }
+    }
+
+    /**
+     \brief Scrolls screen left, rightmost columns are turned off
+     \param nbColumns Number of columns to scroll, lower than 64
+     */
+    void scrollLeft(std::size_t nbColumns) {
+        if (nbColumns == 0)
+            return;
+
+        for (std::size_t rowBegin = 0; rowBegin < m_words.size(); rowBegin += m_wordsPerRow) {
+            for (std::size_t wordId = 0; wordId < m_wordsPerRow; ++wordId) {
+                auto & word {m_words[rowBegin + wordId]};
+                word <<= nbColumns;
+                if (wordId + 1 < m_wordsPerRow)
+                    word |= m_words[rowBegin + wordId + 1] >> (64 - nbColumns);
+            }
+        }
+    }
+
+    /**
+     \brief Compares size and pixels of two framebuffers
+     \param other Framebuffer to compare with
+     \return True if both have the same size and pixels
+     */
+    bool operator==(Framebuffer const& other) const {
+        return m_width == other.m_width && m_height == other.m_height && m_words == other.m_words;
+    }
+
+    /**
+     \brief Compares size and pixels of two framebuffers
+     \param other Framebuffer to compare with
+     \return True if sizes or pixels differ
+     */
+    bool operator!=(Framebuffer const& other) const {
+        return !(*this == other);
+    }
+
+private:
+    /**
+     \brief Gets mask of the pixels stored in the last word of a row
+     \return Mask with one bit set per pixel
+     */
+    std::uint64_t getLastWordMask() const {
+        std::size_t const nbPixels = m_width % 64;
+        return nbPixels == 0 ? ~std::uint64_t(0) : ~std::uint64_t(0) << (64 - nbPixels);
+    }
+
+private:
+    std::size_t m_width = 0;
+    std::size_t m_height = 0;
+    std::size_t m_wordsPerRow = 0;
+    std::vector<std::uint64_t> m_words;
+};
+
+}
+
+#endif /* Framebuffer_hpp */
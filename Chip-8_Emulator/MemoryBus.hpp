@@ -0,0 +1,306 @@
+//
+//  MemoryBus.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef MemoryBus_hpp
+#define MemoryBus_hpp
+
+# include <algorithm>
+# include <cstdint>
+# include <functional>
+# include <optional>
+# include <sstream>
+# include <stdexcept>
+# include <string>
+# include <vector>
+
+namespace chp {
+
+/**
+ \brief Class to access emulated memory
+ \details In range accesses cost one comparison, like a checked vector access. Out of range accesses and hooks are handled out of line, so they do not slow the common case down.
+ */
+class MemoryBus {
+public:
+    /**
+     \brief What to do when an instruction accesses an adress out of memory
+     */
+    enum class OutOfRangePolicy {
+        Wrap, // Adress is wrapped around memory size
+        Fault, // Emulation stops with an error
+        Trap // Access is ignored and emulation is paused as on a breakpoint
+    };
+
+    /**
+     \brief Function called when an hooked adress is read or written
+     \details Parameters are the adress, the value read or written and true for a write
+     */
+    using Hook = std::function<void(std::uint32_t, std::uint8_t, bool)>;
+
+    /**
+     \brief Default constructor
+     */
+    MemoryBus() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~MemoryBus() = default;
+
+
+    /**
+     \brief Resizes memory and fills it with zeros
+     \param size Number of adresses, must not be 0
+     */
+    void resize(std::size_t size) {
+        m_data.assign(size, 0);
+        ++m_generation;
+        m_mask = (size & (size - 1)) == 0 ? size - 1 : 0;
+        updateFastLimit();
+    }
+
+    /**
+     \brief Gets memory size
+     \return The number of adresses
+     */
+    std::size_t getSize() const {
+        return m_data.size();
+    }
+
+    /**
+     \brief Gets the whole memory
+     \return Memory content indexed by adress
+     */
+    std::vector<std::uint8_t> const& getData() const {
+        return m_data;
+    }
+
+    /**
+     \brief Gets number of changes of memory content
+     \details Changes on every write, load or resize, so that a copy of memory only needs to be refreshed when it differs
+     \return The generation of memory content
+     */
+    std::uint64_t getGeneration() const {
+        return m_generation;
+    }
+
+    /**
+     \brief Replaces the whole memory
+     \details Hooks are not called
+     \param data Memory content, must have the current memory size
+     */
+    void setData(std::vector<std::uint8_t> const& data) {
+        m_data = data;
+        ++m_generation;
+    }
+
+    /**
+     \brief Copies bytes in memory without calling hooks
+     \param begin Adress of the first byte
+     \param data Bytes to copy, truncated if they do not fit in memory
+     \param size Number of bytes
+     */
+    void load(std::uint32_t begin, std::uint8_t const* data, std::size_t size) {
+        if (begin >= m_data.size())
+            return;
+        std::copy_n(data, std::min(size, m_data.size() - begin), m_data.begin() + begin);
+        ++m_generation;
+    }
+
+    /**
+     \brief Sets what to do on out of range accesses
+     \param policy The policy to apply
+     */
+    void setOutOfRangePolicy(OutOfRangePolicy policy) {
+        m_policy = policy;
+    }
+
+    /**
+     \brief Parses out of range policy name
+     \param name One of "wrap", "fault" or "trap"
+     \return The policy, std::nullopt if name is unknown
+     */
+    static std::optional<OutOfRangePolicy> parseOutOfRangePolicy(std::string const& name) {
+        if (name == "wrap")
+            return OutOfRangePolicy::Wrap;
+        if (name == "fault")
+            return OutOfRangePolicy::Fault;
+        if (name == "trap")
+            return OutOfRangePolicy::Trap;
+        return std::nullopt;
+    }
+
+    /**
+     \brief Calls hook on every read or write of given adresses
+     \details Opcode fetches do not call hooks. While any hook is set, every read and write takes the slow path.
+     \param first First adress hooked
+     \param last Last adress hooked, included
+     \param hook Function to call
+     */
+    void addHook(std::uint32_t first, std::uint32_t last, Hook hook) {
+        m_hooks.push_back({first, last, std::move(hook)});
+        updateFastLimit();
+    }
+
+    /**
+     \brief Removes all hooks
+     */
+    void clearHooks() {
+        m_hooks.clear();
+        updateFastLimit();
+    }
+
+    /**
+     \brief Reads byte at given adress
+     \param adress Adress to read
+     \return Value read, 0 if access was trapped
+     */
+    std::uint8_t read(std::uint32_t adress) {
+        if (adress < m_fastLimit)
+            return m_data[adress];
+        return readSlow(adress);
+    }
+
+    /**
+     \brief Writes byte at given adress
+     \param adress Adress to write
+     \param value Value to write
+     */
+    void write(std::uint32_t adress, std::uint8_t value) {
+        if (adress < m_fastLimit) {
+            m_data[adress] = value;
+            ++m_generation;
+            return;
+        }
+        writeSlow(adress, value);
+    }
+
+    /**
+     \brief Reads the big endian opcode at given adress
+     \param adress Adress of the most significant byte
+     \return Opcode read, 0 if access was trapped
+     */
+    std::uint16_t fetch(std::uint32_t adress) {
+        if (adress + 1 < m_data.size())
+            return (m_data[adress] << 8) | m_data[adress + 1];
+
+        auto const first {mapAdress(adress, "fetch")};
+        auto const second {mapAdress(adress + 1, "fetch")};
+        if (!first || !second)
+            return 0;
+        return (m_data[*first] << 8) | m_data[*second];
+    }
+
+    /**
+     \brief Pauses emulation after current instruction
+     \details Only the first reason is kept until the trap is taken
+     \param reason Description of what caused the trap
+     */
+    void trap(std::string const& reason) {
+        if (!m_hasTrapped)
+            m_trapReason = reason;
+        m_hasTrapped = true;
+    }
+
+    /**
+     \brief Checks if an access was trapped since last call to takeTrap
+     \return True if emulation must be paused
+     */
+    bool hasTrapped() const {
+        return m_hasTrapped;
+    }
+
+    /**
+     \brief Clears trap
+     \return Description of what caused the trap
+     */
+    std::string takeTrap() {
+        m_hasTrapped = false;
+        return std::move(m_trapReason);
+    }
+
+private:
+    struct HookRange {
+        std::uint32_t first;
+        std::uint32_t last;
+        Hook hook;
+    };
+
+    void updateFastLimit() {
+        m_fastLimit = m_hooks.empty() ? m_data.size() : 0;
+    }
+
+    /**
+     \brief Maps adress in memory according to out of range policy
+     \param adress Adress accessed
+     \param accessName Name of the access, used in error messages
+     \return Adress in memory, std::nullopt if access must be ignored
+     */
+    std::optional<std::uint32_t> mapAdress(std::uint32_t adress, char const* accessName) {
+        if (adress < m_data.size())
+            return adress;
+
+        switch (m_policy) {
+            case OutOfRangePolicy::Wrap:
+                return m_mask != 0 ? adress & m_mask : adress % m_data.size();
+            case OutOfRangePolicy::Fault:
+                throw std::runtime_error("Error: out of range " + std::string(accessName) + " at adress " + toHex(adress));
+            case OutOfRangePolicy::Trap:
+                trap("out of range " + std::string(accessName) + " " + toHex(adress));
+                return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    std::uint8_t readSlow(std::uint32_t adress) {
+        auto const mapped {mapAdress(adress, "read")};
+        if (!mapped)
+            return 0;
+
+        auto const value {m_data[*mapped]};
+        callHooks(*mapped, value, false);
+        return value;
+    }
+
+    void writeSlow(std::uint32_t adress, std::uint8_t value) {
+        auto const mapped {mapAdress(adress, "write")};
+        if (!mapped)
+            return;
+
+        m_data[*mapped] = value;
+        ++m_generation;
+        callHooks(*mapped, value, true);
+    }
+
+    void callHooks(std::uint32_t adress, std::uint8_t value, bool isWrite) {
+        for (auto const& range : m_hooks) {
+            if (range.first <= adress && adress <= range.last)
+                range.hook(adress, value, isWrite);
+        }
+    }
+
+    static std::string toHex(std::uint32_t value) {
+        std::ostringstream stream;
+        stream << std::hex << value;
+        return stream.str();
+    }
+
+private:
+    std::vector<std::uint8_t> m_data;
+    std::uint64_t m_generation = 1;
+    std::size_t m_fastLimit = 0; // Adresses below are read and written directly
+    std::uint32_t m_mask = 0; // Size - 1 if size is a power of two, 0 otherwise
+    OutOfRangePolicy m_policy = OutOfRangePolicy::Wrap;
+
+    std::vector<HookRange> m_hooks;
+
+    bool m_hasTrapped = false;
+    std::string m_trapReason;
+};
+
+}
+
+#endif /* MemoryBus_hpp */
@@ -0,0 +1,201 @@
+//
+//  Opcodes.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Opcodes_hpp
+#define Opcodes_hpp
+
+# include <array>
+# include <cstdint>
+# include <string_view>
+
+namespace chp {
+
+/**
+ \brief Description of an instruction
+ \details In the mnemonic, X and Y are the registers of the second and third nibbles, N, NN and NNN the values of the last 1, 2 and 3 nibbles and I the adress register
+ */
+struct OpcodeInfo {
+    std::string_view pattern; // Opcode with its operands as letters, for example 8XY4
+    std::uint16_t mask; // Bits identifying the instruction
+    std::uint16_t identifier; // Value of these bits
+    std::string_view mnemonic;
+};
+
+/**
+ \brief All instructions, indexed by action id
+ \details Action 0 never matches, it is used for unknown opcodes
+ */
+inline constexpr std::array<OpcodeInfo, 51> OPCODES {
+    OpcodeInfo {"0NNN", 0x0000, 0x0FFF, "SYS NNN"},
+    OpcodeInfo {"00E0", 0xFFFF, 0x00E0, "CLS"},
+    OpcodeInfo {"00EE", 0xFFFF, 0x00EE, "RET"},
+    OpcodeInfo {"1NNN", 0xF000, 0x1000, "JP NNN"},
+    OpcodeInfo {"2NNN", 0xF000, 0x2000, "CALL NNN"},
+    OpcodeInfo {"3XNN", 0xF000, 0x3000, "SE VX, NN"},
+    OpcodeInfo {"4XNN", 0xF000, 0x4000, "SNE VX, NN"},
+    OpcodeInfo {"5XY0", 0xF00F, 0x5000, "SE VX, VY"},
+    OpcodeInfo {"6XNN", 0xF000, 0x6000, "LD VX, NN"},
+    OpcodeInfo {"7XNN", 0xF000, 0x7000, "ADD VX, NN"},
+    OpcodeInfo {"8XY0", 0xF00F, 0x8000, "LD VX, VY"},
+    OpcodeInfo {"8XY1", 0xF00F, 0x8001, "OR VX, VY"},
+    OpcodeInfo {"8XY2", 0xF00F, 0x8002, "AND VX, VY"},
+    OpcodeInfo {"8XY3", 0xF00F, 0x8003, "XOR VX, VY"},
+    OpcodeInfo {"8XY4", 0xF00F, 0x8004, "ADD VX, VY"},
+    OpcodeInfo {"8XY5", 0xF00F, 0x8005, "SUB VX, VY"},
+    OpcodeInfo {"8XY6", 0xF00F, 0x8006, "SHR VX"},
+    OpcodeInfo {"8XY7", 0xF00F, 0x8007, "SUBN VX, VY"},
+    OpcodeInfo {"8XYE", 0xF00F, 0x800E, "SHL VX"},
+    OpcodeInfo {"9XY0", 0xF00F, 0x9000, "SNE VX, VY"},
+    OpcodeInfo {"ANNN", 0xF000, 0xA000, "LD I, NNN"},
+    OpcodeInfo {"BNNN", 0xF000, 0xB000, "JP V0, NNN"},
+    OpcodeInfo {"CXNN", 0xF000, 0xC000, "RND VX, NN"},
+    OpcodeInfo {"DXYN", 0xF000, 0xD000, "DRW VX, VY, N"},
+    OpcodeInfo {"EX9E", 0xF0FF, 0xE09E, "SKP VX"},
+    OpcodeInfo {"EXA1", 0xF0FF, 0xE0A1, "SKNP VX"},
+    OpcodeInfo {"FX07", 0xF0FF, 0xF007, "LD VX, DT"},
+    OpcodeInfo {"FX0A", 0xF0FF, 0xF00A, "LD VX, K"},
+    OpcodeInfo {"FX15", 0xF0FF, 0xF015, "LD DT, VX"},
+    OpcodeInfo {"FX18", 0xF0FF, 0xF018, "LD ST, VX"},
+    OpcodeInfo {"FX1E", 0xF0FF, 0xF01E, "ADD I, VX"},
+    OpcodeInfo {"FX29", 0xF0FF, 0xF029, "LD F, VX"},
+    OpcodeInfo {"FX33", 0xF0FF, 0xF033, "BCD VX"},
+    OpcodeInfo {"FX55", 0xF0FF, 0xF055, "LD [I], VX"},
+    OpcodeInfo {"FX65", 0xF0FF, 0xF065, "LD VX, [I]"},
+    
+    // SCHIP opcodes. DXY0 is handled by DXYN.
+    OpcodeInfo {"00CN", 0xFFF0, 0x00C0, "SCD N"},
+    OpcodeInfo {"00FB", 0xFFFF, 0x00FB, "SCR"},
+    OpcodeInfo {"00FC", 0xFFFF, 0x00FC, "SCL"},
+    OpcodeInfo {"00FD", 0xFFFF, 0x00FD, "EXIT"},
+    OpcodeInfo {"00FE", 0xFFFF, 0x00FE, "LOW"},
+    OpcodeInfo {"00FF", 0xFFFF, 0x00FF, "HIGH"},
+    OpcodeInfo {"FX30", 0xF0FF, 0xF030, "LD HF, VX"},
+    OpcodeInfo {"FX75", 0xF0FF, 0xF075, "LD R, VX"},
+    OpcodeInfo {"FX85", 0xF0FF, 0xF085, "LD VX, R"},
+    
+    // XO-CHIP opcodes
+    OpcodeInfo {"00DN", 0xFFF0, 0x00D0, "SCU N"},
+    OpcodeInfo {"5XY2", 0xF00F, 0x5002, "LD [I], VX-VY"},
+    OpcodeInfo {"5XY3", 0xF00F, 0x5003, "LD VX-VY, [I]"},
+    OpcodeInfo {"F000", 0xFFFF, 0xF000, "LD I, LONG"},
+    OpcodeInfo {"FN01", 0xF0FF, 0xF001, "PLANE X"},
+    OpcodeInfo {"F002", 0xFFFF, 0xF002, "AUDIO"},
+    OpcodeInfo {"FX3A", 0xF0FF, 0xF03A, "PITCH VX"}
+};
+
+namespace details {
+
+/**
+ \brief Gets index of an opcode in the decode table
+ \details Masks only test the second nibble to check that it is 0, so the first nibble, whether X is 0 and the low byte are enough to decode any opcode
+ \param opcode Opcode to decode
+ \return Index in DECODE_TABLE
+ */
+constexpr std::size_t getDecodeIndex(std::uint16_t opcode) {
+    return ((opcode >> 12) << 9) | (((opcode & 0x0F00) != 0) << 8) | (opcode & 0x00FF);
+}
+
+constexpr bool areMasksDecodable() {
+    for (auto const& opcode : OPCODES) {
+        auto const secondNibbleMask = opcode.mask & 0x0F00;
+        if ((secondNibbleMask != 0 && secondNibbleMask != 0x0F00) || (opcode.identifier & 0x0F00 & secondNibbleMask) != 0)
+            return false;
+    }
+    return true;
+}
+
+static_assert(areMasksDecodable(), "Decode table can not distinguish opcodes testing the second nibble against a non 0 value");
+
+/**
+ \brief Matches opcode against all instructions
+ \param opcode Opcode to decode
+ \return Action id of the first instruction matching, 0 if none matches
+ */
+constexpr std::uint8_t matchOpcode(std::uint16_t opcode) {
+    for (std::size_t actionId = 0; actionId < OPCODES.size(); ++actionId) {
+        if (OPCODES[actionId].identifier == (OPCODES[actionId].mask & opcode))
+            return static_cast<std::uint8_t>(actionId);
+    }
+    return 0;
+}
+
+constexpr std::array<std::uint8_t, 16 * 2 * 256> makeDecodeTable() {
+    std::array<std::uint8_t, 16 * 2 * 256> table {};
+    for (std::uint32_t opcode = 0; opcode <= 0xFFFF; opcode += 0x100) {
+        if ((opcode & 0x0F00) > 0x0100)
+            continue; // Only X = 0 and X = 1 need to be tested
+        for (std::uint32_t lowByte = 0; lowByte <= 0xFF; ++lowByte)
+            table[getDecodeIndex(opcode | lowByte)] = matchOpcode(opcode | lowByte);
+    }
+    return table;
+}
+
+}
+
+/**
+ \brief Action id of every opcode, built at compile time from OPCODES
+ */
+inline constexpr auto DECODE_TABLE {details::makeDecodeTable()};
+
+/**
+ \brief Gets instruction of an opcode
+ \param opcode Opcode to decode
+ \return Action id, index of the instruction in OPCODES
+ */
+constexpr std::uint8_t decodeOpcode(std::uint16_t opcode) {
+    return DECODE_TABLE[details::getDecodeIndex(opcode)];
+}
+
+static_assert(decodeOpcode(0x00E0) == 1 && decodeOpcode(0x8123) == 13 && decodeOpcode(0xD120) == 23 && decodeOpcode(0xF000) == 47 && decodeOpcode(0xF100) == 0 && decodeOpcode(0xF301) == 48);
+
+/**
+ \brief Hexadecimal digits 0 to F, 4x5 pixels
+ */
+inline constexpr std::array<std::uint8_t, 80> SMALL_FONT {
+    0xF0, 0x90, 0x90, 0x90, 0xF0, // O
+    0x20, 0x60, 0x20, 0x20, 0x70, // 1
+    0xF0, 0x10, 0xF0, 0x80, 0xF0, // 2
+    0xF0, 0x10, 0xF0, 0x10, 0xF0, // 3
+    0x90, 0x90, 0xF0, 0x10, 0x10, // 4
+    0xF0, 0x80, 0xF0, 0x10, 0xF0, // 5
+    0xF0, 0x80, 0xF0, 0x90, 0xF0, // 6
+    0xF0, 0x10, 0x20, 0x40, 0x40, // 7
+    0xF0, 0x90, 0xF0, 0x90, 0xF0, // 8
+    0xF0, 0x90, 0xF0, 0x10, 0xF0, // 9
+    0xF0, 0x90, 0xF0, 0x90, 0x90, // A
+    0xE0, 0x90, 0xE0, 0x90, 0xE0, // B
+    0xF0, 0x80, 0x80, 0x80, 0xF0, // C
+    0xE0, 0x90, 0x90, 0x90, 0xE0, // D
+    0xF0, 0x80, 0xF0, 0x80, 0xF0, // E
+    0xF0, 0x80, 0xF0, 0x80, 0x80 // F
+};
+
+/**
+ \brief SCHIP hexadecimal digits 0 to F, 8x10 pixels, used by FX30
+ */
+inline constexpr std::array<std::uint8_t, 160> BIG_FONT {
+    0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C, // 0
+    0x18, 0x38, 0x58, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, // 1
+    0x3E, 0x7F, 0xC3, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xFF, 0xFF, // 2
+    0x3C, 0x7E, 0xC3, 0x03, 0x0E, 0x0E, 0x03, 0xC3, 0x7E, 0x3C, // 3
+    0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xFF, 0xFF, 0x06, 0x06, // 4
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFE, 0x03, 0xC3, 0x7E, 0x3C, // 5
+    0x3E, 0x7C, 0xC0, 0xC0, 0xFC, 0xFE, 0xC3, 0xC3, 0x7E, 0x3C, // 6
+    0xFF, 0xFF, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0x60, // 7
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7E, 0x7E, 0xC3, 0xC3, 0x7E, 0x3C, // 8
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7F, 0x3F, 0x03, 0x03, 0x3E, 0x7C, // 9
+    0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, // A
+    0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, // B
+    0x3C, 0xFF, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0xFF, 0x3C, // C
+    0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC, // D
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, // E
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0 // F
+};
+
+}
+
+#endif /* Opcodes_hpp */
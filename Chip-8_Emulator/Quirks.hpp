@@ -0,0 +1,92 @@
+//
+//  Quirks.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Quirks_hpp
+#define Quirks_hpp
+
+# include <cstdint>
+# include <optional>
+# include <sstream>
+# include <string>
+
+namespace chp {
+
+/**
+ \brief Behaviours on which CHIP-8 interpreters disagree
+ \details Without any quirk, the emulator behaves as it always did
+ */
+enum Quirk : std::uint8_t {
+    SHIFT_USES_VY = 0x01, // 8XY6 and 8XYE shift VY into VX instead of shifting VX
+    LOAD_STORE_INCREMENTS_I = 0x02, // FX55 and FX65 leave I at I + X + 1
+    JUMP_USES_VX = 0x04, // BXNN jumps to XNN + VX instead of NNN + V0
+    LOGIC_RESETS_VF = 0x08, // 8XY1, 8XY2 and 8XY3 set VF to 0
+    SPRITES_CLIP = 0x10, // Sprites are clipped at screen edges instead of wrapping around
+    SPRITE_ROWS_VF = 0x20 // In high resolution, DXYN sets VF to the number of rows colliding or clipped at the bottom, as SCHIP 1.1 does
+};
+
+/**
+ \brief Number of quirks combinations, each one having its own instantiation of the interpreter actions
+ */
+constexpr std::size_t NB_QUIRKS_COMBINATIONS = 0x40;
+
+/**
+ \brief Quirks policy resolved at compile time
+ \tparam Flags Combination of Quirk values
+ */
+template <std::uint8_t Flags>
+struct Quirks {
+    static_assert(Flags < NB_QUIRKS_COMBINATIONS, "Unknown quirk");
+
+    static constexpr bool SHIFT_USES_VY = Flags & Quirk::SHIFT_USES_VY;
+    static constexpr bool LOAD_STORE_INCREMENTS_I = Flags & Quirk::LOAD_STORE_INCREMENTS_I;
+    static constexpr bool JUMP_USES_VX = Flags & Quirk::JUMP_USES_VX;
+    static constexpr bool LOGIC_RESETS_VF = Flags & Quirk::LOGIC_RESETS_VF;
+    static constexpr bool SPRITES_CLIP = Flags & Quirk::SPRITES_CLIP;
+    static constexpr bool SPRITE_ROWS_VF = Flags & Quirk::SPRITE_ROWS_VF;
+};
+
+/**
+ \brief Parses quirks from their configuration string
+ \details String is either a profile ("none", "chip8" for the COSMAC VIP, "schip" or "xochip") or quirk names separated with commas among shift_vy, load_store_i, jump_vx, logic_vf, clip and rows_vf. XO-CHIP sets VF to 1 on collision in high resolution too, like Octo, so its profile does not count rows.
+ \param string String to parse
+ \return Combination of Quirk values, std::nullopt if string could not be parsed
+ */
+inline std::optional<std::uint8_t> parseQuirks(std::string const& string) {
+    if (string == "none")
+        return 0;
+    if (string == "chip8")
+        return SHIFT_USES_VY | LOAD_STORE_INCREMENTS_I | LOGIC_RESETS_VF | SPRITES_CLIP;
+    if (string == "schip")
+        return JUMP_USES_VX | SPRITES_CLIP | SPRITE_ROWS_VF;
+    if (string == "xochip")
+        return SHIFT_USES_VY | LOAD_STORE_INCREMENTS_I;
+
+    std::uint8_t quirks = 0;
+    std::stringstream stream(string);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        if (name == "shift_vy")
+            quirks |= SHIFT_USES_VY;
+        else if (name == "load_store_i")
+            quirks |= LOAD_STORE_INCREMENTS_I;
+        else if (name == "jump_vx")
+            quirks |= JUMP_USES_VX;
+        else if (name == "logic_vf")
+            quirks |= LOGIC_RESETS_VF;
+        else if (name == "clip")
+            quirks |= SPRITES_CLIP;
+        else if (name == "rows_vf")
+            quirks |= SPRITE_ROWS_VF;
+        else
+            return std::nullopt;
+    }
+    return quirks;
+}
+
+}
+
+#endif /* Quirks_hpp */
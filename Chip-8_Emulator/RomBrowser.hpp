@@ -0,0 +1,145 @@
+//
+//  RomBrowser.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef RomBrowser_hpp
+#define RomBrowser_hpp
+
+# include <algorithm>
+# include <cctype>
+# include <cstdint>
+# include <filesystem>
+# include <fstream>
+# include <future>
+# include <iterator>
+# include <string>
+# include <vector>
+
+namespace chp {
+
+/**
+ \brief Class to switch between the games of a directory
+ \details Games next to the selected one are read in background, so that switching to them does not wait for the disk
+ */
+class RomBrowser {
+public:
+    /**
+     \brief Default constructor, creates an empty browser
+     */
+    RomBrowser() = default;
+
+    /**
+     \brief Default destructor
+     \details Waits for background reads
+     */
+    ~RomBrowser() = default;
+
+
+    /**
+     \brief Lists games of a directory, sorted by filename
+     \details Files with .ch8, .c8k, .sc8 and .xo8 extensions are listed
+     \param directory Directory storing the games
+     \param currentFilename Game selected if it is in the directory, otherwise the first game is selected
+     \return True if directory could be read
+     */
+    bool open(std::string const& directory, std::string const& currentFilename) {
+        m_filenames.clear();
+        m_images.clear();
+        m_selected = 0;
+
+        std::error_code error;
+        for (std::filesystem::directory_iterator it {directory, error}, end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file(error) && isGame(it->path()))
+                m_filenames.push_back(it->path().string());
+        }
+        if (error)
+            return false;
+
+        std::sort(m_filenames.begin(), m_filenames.end());
+        m_images.resize(m_filenames.size());
+
+        auto const currentName {std::filesystem::path(currentFilename).filename()};
+        for (std::size_t gameId = 0; gameId < m_filenames.size(); ++gameId) {
+            if (std::filesystem::path(m_filenames[gameId]).filename() == currentName)
+                m_selected = gameId;
+        }
+
+        prefetchNeighbours();
+        return true;
+    }
+
+    /**
+     \brief Checks if no game was found
+     \return True if directory has no game
+     */
+    bool isEmpty() const {
+        return m_filenames.empty();
+    }
+
+    /**
+     \brief Gets filename of selected game
+     \return The path of the game
+     */
+    std::string const& getSelectedFilename() const {
+        return m_filenames[m_selected];
+    }
+
+    /**
+     \brief Selects another game and gets its content
+     \details Only waits if the game was not read in background yet, then starts reading the games next to it
+     \param offset Position of the game to select relatively to the current one, wrapping around the list
+     \return The game content, empty if file could not be read
+     */
+    std::vector<std::uint8_t> select(int offset) {
+        auto const nbGames {static_cast<int>(m_filenames.size())};
+        m_selected = ((static_cast<int>(m_selected) + offset) % nbGames + nbGames) % nbGames;
+
+        prefetch(m_selected);
+        auto game {m_images[m_selected].get()};
+
+        prefetchNeighbours();
+        return game;
+    }
+
+private:
+    static bool isGame(std::filesystem::path const& path) {
+        auto extension {path.extension().string()};
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+            return std::tolower(c);
+        });
+        return extension == ".ch8" || extension == ".c8k" || extension == ".sc8" || extension == ".xo8";
+    }
+
+    static std::vector<std::uint8_t> readGame(std::string const& filename) {
+        std::ifstream file(filename, std::ifstream::in | std::ifstream::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /**
+     \brief Starts reading a game in background if it was never read
+     \param gameId Index of the game
+     */
+    void prefetch(std::size_t gameId) {
+        if (!m_images[gameId].valid())
+            m_images[gameId] = std::async(std::launch::async, readGame, m_filenames[gameId]).share();
+    }
+
+    void prefetchNeighbours() {
+        if (m_filenames.empty())
+            return;
+        prefetch((m_selected + 1) % m_filenames.size());
+        prefetch((m_selected + m_filenames.size() - 1) % m_filenames.size());
+    }
+
+private:
+    std::vector<std::string> m_filenames;
+    std::vector<std::shared_future<std::vector<std::uint8_t>>> m_images; // Games are small, so they are kept once read
+    std::size_t m_selected = 0;
+};
+
+}
+
+#endif /* RomBrowser_hpp */
@@ -0,0 +1,164 @@
+//
+//  RomDatabase.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef RomDatabase_hpp
+#define RomDatabase_hpp
+
+# include <cstdint>
+# include <fstream>
+# include <iostream>
+# include <optional>
+# include <sstream>
+# include <string>
+# include <utility>
+# include <vector>
+
+# include "ExternalLibrairies/TSL/hopscotch_map.h"
+
+namespace chp {
+
+/**
+ \brief Settings applied to a specific game
+ \details Settings which are not set keep the value of the configuration file
+ */
+struct RomProfile {
+    std::string name;
+    std::optional<std::string> quirks;
+    std::optional<int> updateFrequency;
+    std::vector<std::pair<std::string, std::string>> keys; // Control name (key_1, pause_key...) and key name
+};
+
+/**
+ \brief Class to find the settings of a game from its content
+ \details Database file is made of sections starting with the hash of a game between brackets, followed by "setting: value" lines. Empty lines and lines starting with # are ignored.
+ */
+class RomDatabase {
+public:
+    /**
+     \brief Default constructor, creates an empty database
+     */
+    RomDatabase() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~RomDatabase() = default;
+
+
+    /**
+     \brief Hashes game content
+     \details Uses 64 bits FNV-1a, which hashes a 64 KB game in a few dozens of microseconds
+     \param data Game content
+     \param size Number of bytes
+     \return The hash of the game
+     */
+    static std::uint64_t hash(std::uint8_t const* data, std::size_t size) {
+        std::uint64_t hash = 0xCBF29CE484222325;
+        for (std::size_t byteId = 0; byteId < size; ++byteId) {
+            hash ^= data[byteId];
+            hash *= 0x100000001B3;
+        }
+        return hash;
+    }
+
+    /**
+     \brief Loads database file, replacing current profiles
+     \details Nothing is done if the file was already loaded
+     \param filename Database filename
+     \return True if file was loaded
+     */
+    bool load(std::string const& filename) {
+        if (filename == m_filename)
+            return true;
+
+        std::ifstream file(filename);
+        if (!file.is_open())
+            return false;
+
+        m_profiles.clear();
+        m_filename = filename;
+
+        RomProfile * profile = nullptr;
+        std::string line;
+        for (std::size_t lineId = 1; std::getline(file, line); ++lineId) {
+            auto const begin {line.find_first_not_of(" \t\r")};
+            if (begin == std::string::npos || line[begin] == '#')
+                continue;
+
+            if (line[begin] == '[') {
+                auto const end {line.find(']', begin)};
+                std::uint64_t gameHash;
+                std::istringstream stream(end == std::string::npos ? "" : line.substr(begin + 1, end - begin - 1));
+                if (!(stream >> std::hex >> gameHash)) {
+                    std::cout << "Error: invalid game hash in " << filename << " at line " << lineId << std::endl;
+                    profile = nullptr;
+                    continue;
+                }
+                profile = &m_profiles[gameHash];
+                continue;
+            }
+
+            auto const separator {line.find(':', begin)};
+            if (!profile || separator == std::string::npos) {
+                std::cout << "Error: unexpected line " << lineId << " in " << filename << std::endl;
+                continue;
+            }
+
+            std::string const setting {trim(line.substr(begin, separator - begin))};
+            std::string const value {trim(line.substr(separator + 1))};
+            if (setting == "name") {
+                profile->name = value;
+            } else if (setting == "quirks") {
+                profile->quirks = value;
+            } else if (setting == "update_frequency") {
+                try {
+                    profile->updateFrequency = std::stoi(value);
+                } catch (std::exception const&) {
+                    std::cout << "Error: invalid update_frequency in " << filename << " at line " << lineId << std::endl;
+                }
+            } else {
+                profile->keys.emplace_back(setting, value);
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     \brief Gets settings of a game
+     \param gameHash Hash of the game content, computed with hash()
+     \return The profile of the game, nullptr if game is unknown
+     */
+    RomProfile const* find(std::uint64_t gameHash) const {
+        auto const it {m_profiles.find(gameHash)};
+        return it != m_profiles.end() ? &it->second : nullptr;
+    }
+
+    /**
+     \brief Gets number of games in database
+     \return The number of profiles
+     */
+    std::size_t getSize() const {
+        return m_profiles.size();
+    }
+
+private:
+    static std::string trim(std::string const& string) {
+        auto const begin {string.find_first_not_of(" \t\r")};
+        if (begin == std::string::npos)
+            return "";
+        return string.substr(begin, string.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+private:
+    std::string m_filename;
+    tsl::hopscotch_map<std::uint64_t, RomProfile> m_profiles;
+};
+
+}
+
+#endif /* RomDatabase_hpp */
@@ -0,0 +1,174 @@
+//
+//  Screenshot.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Screenshot_hpp
+#define Screenshot_hpp
+
+# include <algorithm>
+# include <array>
+# include <cstdint>
+# include <fstream>
+# include <ostream>
+# include <string>
+# include <vector>
+
+namespace chp {
+
+/**
+ \brief Class to write an RGB image in PPM or PNG format
+ \details Images are encoded without any graphics library nor display. PNG data is stored without compression, so that a given image always gives the same file.
+ */
+class Screenshot {
+public:
+    /**
+     \brief Constructor, creates a black image
+     \param width Width in pixels
+     \param height Height in pixels
+     */
+    Screenshot(std::size_t width, std::size_t height) :
+    m_width(width),
+    m_height(height),
+    m_pixels(width * height * 3, 0)
+    {
+    }
+
+    /**
+     \brief Default destructor
+     */
+    ~Screenshot() = default;
+
+
+    /**
+     \brief Sets color of a pixel
+     \param x Column of the pixel
+     \param y Row of the pixel
+     \param red Red component
+     \param green Green component
+     \param blue Blue component
+     */
+    void setPixel(std::size_t x, std::size_t y, std::uint8_t red, std::uint8_t green, std::uint8_t blue) {
+        auto const pixel {m_pixels.begin() + (y * m_width + x) * 3};
+        pixel[0] = red;
+        pixel[1] = green;
+        pixel[2] = blue;
+    }
+
+    /**
+     \brief Writes image in a file
+     \param filename Path of the file, its extension (.png or .ppm) gives the format
+     \return False if extension is unknown or file could not be written
+     */
+    bool save(std::string const& filename) const {
+        auto const extension {filename.substr(std::min(filename.rfind('.'), filename.size()))};
+        if (extension != ".png" && extension != ".ppm")
+            return false;
+
+        std::ofstream file(filename, std::ios::binary);
+        if (extension == ".png")
+            writePng(file);
+        else
+            writePpm(file);
+        return static_cast<bool>(file);
+    }
+
+    /**
+     \brief Writes image in binary PPM format (P6)
+     \param output Stream to write the image in
+     */
+    void writePpm(std::ostream & output) const {
+        output << "P6\n" << m_width << " " << m_height << "\n255\n";
+        output.write(reinterpret_cast<char const*>(m_pixels.data()), m_pixels.size());
+    }
+
+    /**
+     \brief Writes image in PNG format
+     \param output Stream to write the image in
+     */
+    void writePng(std::ostream & output) const {
+        output.write("\x89PNG\r\n\x1a\n", 8);
+
+        std::vector<std::uint8_t> header;
+        appendBigEndian(header, static_cast<std::uint32_t>(m_width));
+        appendBigEndian(header, static_cast<std::uint32_t>(m_height));
+        header.insert(header.end(), {8, 2, 0, 0, 0}); // 8 bits RGB, no interlacing
+        writeChunk(output, "IHDR", header);
+
+        // Each row starts with filter type 0, then rows are stored in a zlib stream of uncompressed blocks
+        std::vector<std::uint8_t> rows;
+        rows.reserve(m_height * (m_width * 3 + 1));
+        for (std::size_t y = 0; y < m_height; ++y) {
+            rows.push_back(0);
+            rows.insert(rows.end(), m_pixels.begin() + y * m_width * 3, m_pixels.begin() + (y + 1) * m_width * 3);
+        }
+
+        constexpr std::size_t MAX_BLOCK_SIZE = 0xFFFF;
+        std::vector<std::uint8_t> data {0x78, 0x01};
+        for (std::size_t begin = 0; begin < rows.size() || begin == 0; begin += MAX_BLOCK_SIZE) {
+            auto const size {std::min(MAX_BLOCK_SIZE, rows.size() - begin)};
+            data.push_back(begin + size >= rows.size() ? 1 : 0); // Last block flag
+            data.insert(data.end(), {static_cast<std::uint8_t>(size & 0xFF), static_cast<std::uint8_t>(size >> 8),
+                static_cast<std::uint8_t>(~size & 0xFF), static_cast<std::uint8_t>((~size >> 8) & 0xFF)});
+            data.insert(data.end(), rows.begin() + begin, rows.begin() + begin + size);
+        }
+        appendBigEndian(data, adler32(rows));
+        writeChunk(output, "IDAT", data);
+
+        writeChunk(output, "IEND", {});
+    }
+
+private:
+    static void appendBigEndian(std::vector<std::uint8_t> & data, std::uint32_t value) {
+        data.insert(data.end(), {static_cast<std::uint8_t>(value >> 24), static_cast<std::uint8_t>(value >> 16),
+            static_cast<std::uint8_t>(value >> 8), static_cast<std::uint8_t>(value)});
+    }
+
+    static void writeChunk(std::ostream & output, char const* type, std::vector<std::uint8_t> const& data) {
+        std::vector<std::uint8_t> chunk;
+        appendBigEndian(chunk, static_cast<std::uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        appendBigEndian(chunk, crc32(chunk.data() + 4, chunk.size() - 4)); // Checksum covers type and data
+        output.write(reinterpret_cast<char const*>(chunk.data()), chunk.size());
+    }
+
+    static std::uint32_t crc32(std::uint8_t const* data, std::size_t size) {
+        static auto const table {[] {
+            std::array<std::uint32_t, 256> table;
+            for (std::uint32_t byte = 0; byte < 256; ++byte) {
+                std::uint32_t crc = byte;
+                for (int bitId = 0; bitId < 8; ++bitId)
+                    crc = (crc & 1) ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+                table[byte] = crc;
+            }
+            return table;
+        }()};
+
+        std::uint32_t crc = 0xFFFFFFFF;
+        for (std::size_t byteId = 0; byteId < size; ++byteId)
+            crc = table[(crc ^ data[byteId]) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFF;
+    }
+
+    static std::uint32_t adler32(std::vector<std::uint8_t> const& data) {
+        std::uint32_t a = 1;
+        std::uint32_t b = 0;
+        for (auto byte : data) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        return (b << 16) | a;
+    }
+
+private:
+    std::size_t m_width;
+    std::size_t m_height;
+    std::vector<std::uint8_t> m_pixels; // RGB, row by row
+};
+
+}
+
+#endif /* Screenshot_hpp */
@@ -0,0 +1,105 @@
+//
+//  SpscQueue.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef SpscQueue_hpp
+#define SpscQueue_hpp
+
+# include <array>
+# include <atomic>
+# include <cstddef>
+
+namespace chp {
+
+/**
+ \brief Wait-free bounded queue with a single producer thread and a single consumer thread
+ \details Values are stored in a fixed ring buffer, pushing and popping never allocate nor lock
+ \tparam T Type of the values queued
+ \tparam Capacity Number of values the queue can hold, must be a power of two
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    /**
+     \brief Default constructor
+     */
+    SpscQueue() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~SpscQueue() = default;
+
+    /**
+     \brief Deleted copy constructor
+     */
+    SpscQueue(SpscQueue const& other) = delete;
+
+    /**
+     \brief Deleted assignement operator
+     */
+    SpscQueue& operator=(SpscQueue const& other) = delete;
+
+
+    /**
+     \brief Pushes value at the end of queue
+     \details Must only be called by producer thread
+     \param value Value to push
+     \return False if queue is full, in this case value is not pushed
+     */
+    bool push(T const& value) {
+        auto const tail {m_tail.load(std::memory_order_relaxed)};
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_buffer[tail & MASK] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     \brief Gets value at the front of queue without removing it
+     \details Must only be called by consumer thread
+     \return Ptr on front value, nullptr if queue is empty
+     */
+    T const* front() const {
+        auto const head {m_head.load(std::memory_order_relaxed)};
+        if (head == m_tail.load(std::memory_order_acquire))
+            return nullptr;
+
+        return &m_buffer[head & MASK];
+    }
+
+    /**
+     \brief Removes value at the front of queue
+     \details Must only be called by consumer thread, after front returned a value
+     */
+    void pop() {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     \brief Removes all values queued
+     \details Must only be called by consumer thread
+     */
+    void clear() {
+        m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    std::array<T, Capacity> m_buffer;
+
+    alignas(64) std::atomic<std::size_t> m_head {0};
+    alignas(64) std::atomic<std::size_t> m_tail {0};
+};
+
+}
+
+#endif /* SpscQueue_hpp */
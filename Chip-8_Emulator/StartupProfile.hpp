@@ -0,0 +1,98 @@
+//
+//  StartupProfile.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef StartupProfile_hpp
+#define StartupProfile_hpp
+
+# include <chrono>
+# include <iomanip>
+# include <ostream>
+# include <string>
+# include <utility>
+# include <vector>
+
+namespace chp {
+
+/**
+ \brief Class to measure how long each startup step takes
+ \details Steps are only recorded while the profile is enabled, so that it costs nothing otherwise
+ */
+class StartupProfile {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     \brief Default constructor, creates a disabled profile
+     */
+    StartupProfile() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~StartupProfile() = default;
+
+
+    /**
+     \brief Enables profile and starts measuring time
+     */
+    void start() {
+        m_isEnabled = true;
+        m_begin = Clock::now();
+        m_steps.clear();
+    }
+
+    /**
+     \brief Checks if steps are recorded
+     \return True if profile was started and not printed yet
+     */
+    bool isEnabled() const {
+        return m_isEnabled;
+    }
+
+    /**
+     \brief Records end of a startup step
+     \param step Description of the step
+     */
+    void mark(std::string step) {
+        if (m_isEnabled)
+            m_steps.emplace_back(std::move(step), Clock::now());
+    }
+
+    /**
+     \brief Prints duration of each step and disables profile
+     \param output Stream to print the steps in
+     */
+    void print(std::ostream & output) {
+        if (!m_isEnabled)
+            return;
+
+        output << "Startup profile:" << std::endl;
+        auto previous {m_begin};
+        for (auto const& [step, time] : m_steps) {
+            output << "  " << std::left << std::setw(24) << step << std::right << std::fixed << std::setprecision(2)
+                << std::setw(9) << toMilliseconds(time - m_begin) << " ms (+" << toMilliseconds(time - previous) << " ms)" << std::endl;
+            previous = time;
+        }
+        output << std::defaultfloat;
+
+        m_isEnabled = false;
+    }
+
+private:
+    static float toMilliseconds(Clock::duration duration) {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+
+private:
+    bool m_isEnabled = false;
+    Clock::time_point m_begin;
+    std::vector<std::pair<std::string, Clock::time_point>> m_steps;
+};
+
+}
+
+#endif /* StartupProfile_hpp */
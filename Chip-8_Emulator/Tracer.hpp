@@ -0,0 +1,236 @@
+//
+//  Tracer.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Tracer_hpp
+#define Tracer_hpp
+
+# include <algorithm>
+# include <array>
+# include <cstdint>
+# include <fstream>
+# include <string>
+# include <vector>
+
+namespace chp {
+
+/**
+ \brief Class to record executed instructions in a fixed size ring buffer
+ \details Each entry takes 8 bytes. When buffer is full, the oldest entries are overwritten.
+ Instructions loading a range of registers (FX65, 5XY3 and FX85) are followed by register entries, each storing the values of up to 8 written registers, so that every changed register can be read from the trace.
+ */
+class Tracer {
+public:
+    /**
+     \brief Structure storing one executed instruction
+     */
+    struct Entry {
+        std::uint16_t programCounter;
+        std::uint16_t opcode;
+        std::uint16_t registerAdress; // I after instruction
+        std::uint8_t registerX; // VX after instruction, X being read from opcode
+        std::uint8_t registerF; // VF after instruction
+    };
+    static_assert(sizeof(Entry) == 8, "Trace entries must stay compact");
+
+    /**
+     \brief Structure storing registers written by an instruction besides VX and VF
+     */
+    struct RegisterRange {
+        std::uint8_t first = 0;
+        std::uint8_t nbRegisters = 0; // 0 if instruction only writes VX and VF
+    };
+
+    /**
+     \brief Default constructor
+     */
+    Tracer() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~Tracer() = default;
+
+
+    /**
+     \brief Sets number of entries kept and clears the trace
+     \param nbEntries Number of entries, rounded up to a power of two. 0 disables tracing.
+     */
+    void resize(std::size_t nbEntries) {
+        std::size_t capacity = nbEntries > 0 ? 1 : 0;
+        while (capacity < nbEntries)
+            capacity <<= 1;
+
+        m_entries.assign(capacity, {});
+        m_isRegisterEntry.assign(capacity, false);
+        m_mask = capacity > 0 ? capacity - 1 : 0;
+        m_nbRecorded = 0;
+    }
+
+    /**
+     \brief Checks if tracing is enabled
+     \return True if instructions must be recorded
+     */
+    bool isEnabled() const {
+        return !m_entries.empty();
+    }
+
+    /**
+     \brief Records an instruction
+     \param entry The instruction to record
+     \param registers Registers after instruction, stored in register entries if instruction loads a range of them
+     */
+    void record(Entry const& entry, std::array<std::uint8_t, 16> const& registers) {
+        push(entry, false);
+
+        auto const range {getWrittenRegisters(entry.opcode)};
+        for (std::size_t registerId = range.first; registerId < range.first + range.nbRegisters; registerId += 8) {
+            std::array<std::uint8_t, 8> values {};
+            std::copy(registers.begin() + registerId, registers.begin() + std::min<std::size_t>(registerId + 8, range.first + range.nbRegisters), values.begin());
+            push(packRegisters(values), true);
+        }
+    }
+
+    /**
+     \brief Gets registers written by an instruction besides VX and VF
+     \details Opcode nibbles are matched directly since this is called for every traced instruction
+     \param opcode Opcode of the instruction
+     \return The range of registers, stored in register entries following the instruction entry
+     */
+    static RegisterRange getWrittenRegisters(std::uint16_t opcode) {
+        auto const x {static_cast<std::uint8_t>((opcode & 0x0F00) >> 8)};
+        auto const y {static_cast<std::uint8_t>((opcode & 0x00F0) >> 4)};
+
+        switch (opcode & 0xF000) {
+            case 0x5000: // 5XY3
+                if ((opcode & 0x000F) == 0x3)
+                    return {std::min(x, y), static_cast<std::uint8_t>((x > y ? x - y : y - x) + 1)};
+                break;
+            case 0xF000: // FX65 and FX85
+                if ((opcode & 0x00FF) == 0x65 || (opcode & 0x00FF) == 0x85)
+                    return {0, static_cast<std::uint8_t>(x + 1)};
+                break;
+        }
+        return {};
+    }
+
+    /**
+     \brief Gets number of register entries following an instruction entry
+     */
+    static std::size_t getNbRegisterEntries(std::uint16_t opcode) {
+        return (getWrittenRegisters(opcode).nbRegisters + 7) / 8;
+    }
+
+    /**
+     \brief Reads the values of a register entry
+     \return Values of 8 consecutive registers, the last ones are 0 if fewer registers were written
+     */
+    static std::array<std::uint8_t, 8> unpackRegisters(Entry const& entry) {
+        return {static_cast<std::uint8_t>(entry.programCounter & 0xFF), static_cast<std::uint8_t>(entry.programCounter >> 8),
+            static_cast<std::uint8_t>(entry.opcode & 0xFF), static_cast<std::uint8_t>(entry.opcode >> 8),
+            static_cast<std::uint8_t>(entry.registerAdress & 0xFF), static_cast<std::uint8_t>(entry.registerAdress >> 8),
+            entry.registerX, entry.registerF};
+    }
+
+    /**
+     \brief Writes trace in binary file
+     \details File contains the magic "C8TR", the number of entries and the cycle following the last entry (both on 8 bytes), then entries from oldest to newest. All values are little endian. Register entries whose instruction entry was overwritten are not written, so that the file starts with an instruction.
+     \param filename Path of the file to write
+     \param cycle Cycle following the last recorded instruction
+     \return True if file could be written
+     */
+    bool dump(std::string const& filename, std::uint64_t cycle) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        std::uint64_t nbEntries = std::min<std::uint64_t>(m_nbRecorded, m_entries.size());
+        while (nbEntries > 0 && m_isRegisterEntry[(m_nbRecorded - nbEntries) & m_mask])
+            --nbEntries;
+
+        file.write(MAGIC, 4);
+        writeValue(file, nbEntries, 8);
+        writeValue(file, cycle, 8);
+
+        for (std::uint64_t entryId = m_nbRecorded - nbEntries; entryId < m_nbRecorded; ++entryId) {
+            auto const& entry {m_entries[entryId & m_mask]};
+            writeValue(file, entry.programCounter, 2);
+            writeValue(file, entry.opcode, 2);
+            writeValue(file, entry.registerAdress, 2);
+            writeValue(file, entry.registerX, 1);
+            writeValue(file, entry.registerF, 1);
+        }
+
+        return file.good();
+    }
+
+    /**
+     \brief Reads trace from binary file written by dump
+     \param filename Path of the file to read
+     \param entries Vector where to store entries read, from oldest to newest, register entries following their instruction
+     \param cycle Where to store the cycle following the last entry
+     \return True if file could be read
+     */
+    static bool load(std::string const& filename, std::vector<Entry> & entries, std::uint64_t & cycle) {
+        std::ifstream file(filename, std::ios::binary);
+        char magic[4];
+        if (!file.is_open() || !file.read(magic, 4) || std::string(magic, 4) != std::string(MAGIC, 4))
+            return false;
+
+        std::uint64_t const nbEntries = readValue(file, 8);
+        cycle = readValue(file, 8);
+
+        entries.clear();
+        for (std::uint64_t entryId = 0; entryId < nbEntries && file.good(); ++entryId) {
+            Entry entry;
+            entry.programCounter = static_cast<std::uint16_t>(readValue(file, 2));
+            entry.opcode = static_cast<std::uint16_t>(readValue(file, 2));
+            entry.registerAdress = static_cast<std::uint16_t>(readValue(file, 2));
+            entry.registerX = static_cast<std::uint8_t>(readValue(file, 1));
+            entry.registerF = static_cast<std::uint8_t>(readValue(file, 1));
+            entries.push_back(entry);
+        }
+
+        return file.good();
+    }
+
+private:
+    void push(Entry const& entry, bool isRegisterEntry) {
+        m_entries[m_nbRecorded & m_mask] = entry;
+        m_isRegisterEntry[m_nbRecorded & m_mask] = isRegisterEntry;
+        ++m_nbRecorded;
+    }
+
+    // Register values are stored in file order, as if the entry was 8 bytes
+    static Entry packRegisters(std::array<std::uint8_t, 8> const& values) {
+        return {static_cast<std::uint16_t>(values[0] | (values[1] << 8)), static_cast<std::uint16_t>(values[2] | (values[3] << 8)),
+            static_cast<std::uint16_t>(values[4] | (values[5] << 8)), values[6], values[7]};
+    }
+
+    static void writeValue(std::ofstream & file, std::uint64_t value, std::size_t nbBytes) {
+        for (std::size_t byteId = 0; byteId < nbBytes; ++byteId)
+            file.put(static_cast<char>((value >> (byteId * 8)) & 0xFF));
+    }
+
+    static std::uint64_t readValue(std::ifstream & file, std::size_t nbBytes) {
+        std::uint64_t value = 0;
+        for (std::size_t byteId = 0; byteId < nbBytes; ++byteId)
+            value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(file.get())) << (byteId * 8);
+        return value;
+    }
+
+private:
+    static constexpr char MAGIC[4] = {'C', '8', 'T', 'R'};
+
+    std::vector<Entry> m_entries;
+    std::vector<bool> m_isRegisterEntry;
+    std::size_t m_mask = 0;
+    std::uint64_t m_nbRecorded = 0;
+};
+
+}
+
+#endif /* Tracer_hpp */
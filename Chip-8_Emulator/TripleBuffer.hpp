@@ -0,0 +1,100 @@
+//
+//  TripleBuffer.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef TripleBuffer_hpp
+#define TripleBuffer_hpp
+
+# include <array>
+# include <atomic>
+# include <cstdint>
+
+namespace chp {
+
+/**
+ \brief Lock-free triple buffer to share the latest value produced by one thread with another thread
+ \details The producer writes in the back buffer then publishes it, the consumer reads the front buffer after fetching the latest published one. Neither thread ever waits for the other: the producer overwrites frames not consumed yet and the consumer keeps its front buffer until a new one is published.
+ \tparam T Type of the values shared
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     \brief Default constructor
+     */
+    TripleBuffer() = default;
+
+    /**
+     \brief Default destructor
+     */
+    ~TripleBuffer() = default;
+
+    /**
+     \brief Deleted copy constructor
+     */
+    TripleBuffer(TripleBuffer const& other) = delete;
+
+    /**
+     \brief Deleted assignement operator
+     */
+    TripleBuffer& operator=(TripleBuffer const& other) = delete;
+
+
+    /**
+     \brief Gets buffer to write in
+     \details Must only be called by producer thread
+     \return The back buffer
+     */
+    T & back() {
+        return m_buffers[m_backId];
+    }
+
+    /**
+     \brief Publishes back buffer to the consumer
+     \details Must only be called by producer thread. A new back buffer is given to the producer, its content is the one of a previous frame.
+     */
+    void publish() {
+        auto const previous {m_middle.exchange(static_cast<std::uint8_t>(m_backId | DIRTY_FLAG), std::memory_order_acq_rel)};
+        m_backId = previous & INDEX_MASK;
+    }
+
+    /**
+     \brief Fetches the latest published buffer
+     \details Must only be called by consumer thread
+     \return True if a new buffer was published since last call
+     */
+    bool update() {
+        if (!(m_middle.load(std::memory_order_relaxed) & DIRTY_FLAG))
+            return false;
+
+        auto const previous {m_middle.exchange(m_frontId, std::memory_order_acq_rel)};
+        m_frontId = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     \brief Gets the latest buffer fetched
+     \details Must only be called by consumer thread
+     \return The front buffer
+     */
+    T const& front() const {
+        return m_buffers[m_frontId];
+    }
+
+private:
+    static constexpr std::uint8_t DIRTY_FLAG = 0x4;
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+
+    std::array<T, 3> m_buffers;
+
+    std::uint8_t m_backId = 0;
+    std::atomic<std::uint8_t> m_middle {1};
+    std::uint8_t m_frontId = 2;
+};
+
+}
+
+#endif /* TripleBuffer_hpp */
@@ -0,0 +1,341 @@
+//
+//  VideoRecorder.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef VideoRecorder_hpp
+#define VideoRecorder_hpp
+
+# include <algorithm>
+# include <array>
+# include <atomic>
+# include <chrono>
+# include <cstdint>
+# include <fstream>
+# include <functional>
+# include <initializer_list>
+# include <string>
+# include <thread>
+# include <vector>
+
+# include "SpscQueue.hpp"
+
+namespace chp {
+
+/**
+ \brief Class to record emulated frames in a compact lossless video
+ \details Frames are pushed without blocking and encoded by a background thread. Each frame is stored as the bytes that differ from the previous one, and unchanged frames only increase a repeat counter, so that hours of recording take little space.
+
+ File format (.c8v): "C8V", version byte and frame rate (16 bits), then records starting with a tag:
+  - RESOLUTION: width and height (16 bits each) and number of planes (8 bits), previous frame becomes blank
+  - DELTA: XOR with previous frame as pairs of varints (number of unchanged bytes, number of changed bytes) followed by the changed bytes, until the frame is covered
+  - REPEAT: varint number of times previous frame is shown again
+ Multi-byte fixed values are big endian, varints store 7 bits per byte, least significant first.
+ */
+class VideoRecorder {
+public:
+    static constexpr std::size_t MAX_FRAME_SIZE = 128 * 64 / 8 * 2; // Bytes of a high resolution frame with two planes
+
+    /**
+     \brief Bits of the planes of a frame
+     \details Plane after plane, row after row, 8 pixels per byte with the leftmost pixel in the most significant bit
+     */
+    struct Frame {
+        std::uint16_t width = 0;
+        std::uint16_t height = 0;
+        std::uint8_t nbPlanes = 0;
+        std::array<std::uint8_t, MAX_FRAME_SIZE> bits;
+
+        /**
+         \brief Gets number of bytes of a row
+         */
+        std::size_t getBytesPerRow() const {
+            return (width + 7) / 8;
+        }
+
+        /**
+         \brief Gets number of bytes used in bits
+         */
+        std::size_t getSize() const {
+            return getBytesPerRow() * height * nbPlanes;
+        }
+
+        /**
+         \brief Gets palette index of a pixel
+         \return Bit of each plane, first plane in least significant bit
+         */
+        std::size_t getColorId(std::size_t x, std::size_t y) const {
+            std::size_t colorId = 0;
+            for (std::size_t planeId = 0; planeId < nbPlanes; ++planeId) {
+                auto const byte {bits[(planeId * height + y) * getBytesPerRow() + x / 8]};
+                colorId |= ((byte >> (7 - x % 8)) & 0x1) << planeId;
+            }
+            return colorId;
+        }
+    };
+
+    /**
+     \brief Function called for each decoded frame that differs from the previous one
+     \details Parameters are the number of the frame, counted from 0, and the frame
+     */
+    using FrameCallback = std::function<void(std::uint64_t, Frame const&)>;
+
+    /**
+     \brief Default constructor, creates a stopped recorder
+     */
+    VideoRecorder() = default;
+
+    /**
+     \brief Destructor
+     \details Encodes frames still queued and closes the file
+     */
+    ~VideoRecorder() {
+        stop();
+    }
+
+
+    /**
+     \brief Opens video file and starts encoding thread
+     \param filename Path of the video file, overwritten
+     \param frameRate Number of frames pushed per second, stored for players
+     \return False if file could not be opened
+     */
+    bool start(std::string const& filename, std::uint16_t frameRate) {
+        stop();
+
+        m_file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open())
+            return false;
+
+        m_file.write("C8V", 3);
+        writeBytes({VERSION, static_cast<std::uint8_t>(frameRate >> 8), static_cast<std::uint8_t>(frameRate & 0xFF)});
+
+        m_previous = Frame();
+        m_nbRepeats = 0;
+        m_nbFrames = 0;
+        m_nbDroppedFrames = 0;
+        m_isRecording = true;
+        m_encoderThread = std::thread(&VideoRecorder::encode, this);
+        return true;
+    }
+
+    /**
+     \brief Encodes frames still queued, closes video file and stops encoding thread
+     */
+    void stop() {
+        if (!m_encoderThread.joinable())
+            return;
+
+        m_isRecording = false;
+        m_encoderThread.join();
+        m_file.close();
+    }
+
+    /**
+     \brief Checks if frames are recorded
+     */
+    bool isRecording() const {
+        return m_encoderThread.joinable();
+    }
+
+    /**
+     \brief Queues frame to be encoded
+     \details Never blocks: if encoding thread is late and queue is full, frame is dropped. Must only be called by one thread.
+     \param frame Frame to record
+     \return False if frame was dropped
+     */
+    bool push(Frame const& frame) {
+        ++m_nbFrames;
+        if (m_queue.push(frame))
+            return true;
+        ++m_nbDroppedFrames;
+        return false;
+    }
+
+    /**
+     \brief Gets number of frames pushed since recording started
+     */
+    std::uint64_t getNbFrames() const {
+        return m_nbFrames;
+    }
+
+    /**
+     \brief Gets number of frames dropped since recording started
+     */
+    std::uint64_t getNbDroppedFrames() const {
+        return m_nbDroppedFrames;
+    }
+
+    /**
+     \brief Decodes a video file
+     \param filename Path of the video file
+     \param frameRate Set to the frame rate of the video
+     \param callback Function called for each frame that differs from the previous one
+     \return Number of frames of the video, 0 if file could not be read or is invalid
+     */
+    static std::uint64_t decode(std::string const& filename, std::uint16_t & frameRate, FrameCallback const& callback) {
+        std::ifstream file(filename, std::ios::binary);
+        std::array<char, 6> header;
+        if (!file.read(header.data(), header.size()) || std::string(header.data(), 3) != "C8V" || header[3] != VERSION)
+            return 0;
+        frameRate = static_cast<std::uint16_t>((static_cast<std::uint8_t>(header[4]) << 8) | static_cast<std::uint8_t>(header[5]));
+
+        Frame frame;
+        std::uint64_t nbFrames = 0;
+        for (int tag; (tag = file.get()) != std::char_traits<char>::eof();) {
+            if (tag == RESOLUTION) {
+                std::array<char, 5> resolution;
+                if (!file.read(resolution.data(), resolution.size()))
+                    return 0;
+                frame.width = static_cast<std::uint16_t>((static_cast<std::uint8_t>(resolution[0]) << 8) | static_cast<std::uint8_t>(resolution[1]));
+                frame.height = static_cast<std::uint16_t>((static_cast<std::uint8_t>(resolution[2]) << 8) | static_cast<std::uint8_t>(resolution[3]));
+                frame.nbPlanes = static_cast<std::uint8_t>(resolution[4]);
+                if (frame.getSize() > MAX_FRAME_SIZE)
+                    return 0;
+                frame.bits.fill(0);
+            } else if (tag == DELTA) {
+                for (std::size_t byteId = 0; byteId < frame.getSize();) {
+                    auto const nbUnchanged {readVarint(file)};
+                    auto const nbChanged {readVarint(file)};
+                    if (!file || nbUnchanged + nbChanged == 0 || nbUnchanged + nbChanged > frame.getSize() - byteId)
+                        return 0;
+
+                    byteId += nbUnchanged;
+                    for (std::uint64_t changeId = 0; changeId < nbChanged; ++changeId)
+                        frame.bits[byteId++] ^= static_cast<std::uint8_t>(file.get());
+                }
+                if (!file)
+                    return 0;
+                callback(nbFrames++, frame);
+            } else if (tag == REPEAT) {
+                auto const nbRepeats {readVarint(file)};
+                if (!file)
+                    return 0;
+                nbFrames += nbRepeats;
+            } else {
+                return 0;
+            }
+        }
+        return nbFrames;
+    }
+
+private:
+    static constexpr std::uint8_t VERSION = 1;
+
+    enum Tag : std::uint8_t {
+        RESOLUTION = 1,
+        DELTA = 2,
+        REPEAT = 3
+    };
+
+    void writeBytes(std::initializer_list<std::uint8_t> bytes) {
+        for (auto byte : bytes)
+            m_file.put(static_cast<char>(byte));
+    }
+
+    void writeVarint(std::uint64_t value) {
+        for (; value >= 0x80; value >>= 7)
+            m_file.put(static_cast<char>((value & 0x7F) | 0x80));
+        m_file.put(static_cast<char>(value));
+    }
+
+    static std::uint64_t readVarint(std::istream & input) {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto const byte {input.get()};
+            if (byte == std::char_traits<char>::eof())
+                break;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        input.setstate(std::ios::failbit);
+        return 0;
+    }
+
+    /**
+     \brief Encodes queued frames until recording stops
+     \details File is flushed whenever queue is empty, so that a recording survives a crash of the emulator (except the last repeated frames)
+     */
+    void encode() {
+        while (true) {
+            auto const isStopping {!m_isRecording.load(std::memory_order_acquire)};
+
+            if (auto const frame {m_queue.front()}) {
+                encodeFrame(*frame);
+                m_queue.pop();
+                continue;
+            }
+            if (isStopping)
+                break;
+
+            m_file.flush(); // Repeats are kept pending, so that idle periods stay a single record
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        flushRepeats();
+        m_file.flush();
+    }
+
+    void encodeFrame(Frame const& frame) {
+        auto const size {frame.getSize()};
+        if (size > MAX_FRAME_SIZE)
+            return;
+
+        bool const isSameResolution = frame.width == m_previous.width && frame.height == m_previous.height && frame.nbPlanes == m_previous.nbPlanes;
+        if (isSameResolution && std::equal(frame.bits.begin(), frame.bits.begin() + size, m_previous.bits.begin())) {
+            ++m_nbRepeats;
+            return;
+        }
+
+        flushRepeats();
+        if (!isSameResolution) {
+            writeBytes({RESOLUTION, static_cast<std::uint8_t>(frame.width >> 8), static_cast<std::uint8_t>(frame.width & 0xFF),
+                static_cast<std::uint8_t>(frame.height >> 8), static_cast<std::uint8_t>(frame.height & 0xFF), frame.nbPlanes});
+            m_previous = frame;
+            m_previous.bits.fill(0);
+        }
+
+        writeBytes({DELTA});
+        for (std::size_t byteId = 0; byteId < size;) {
+            auto const changedBegin {static_cast<std::size_t>(std::mismatch(frame.bits.begin() + byteId, frame.bits.begin() + size, m_previous.bits.begin() + byteId).first - frame.bits.begin())};
+            std::size_t changedEnd = changedBegin;
+            while (changedEnd < size && frame.bits[changedEnd] != m_previous.bits[changedEnd])
+                ++changedEnd;
+
+            writeVarint(changedBegin - byteId);
+            writeVarint(changedEnd - changedBegin);
+            for (auto changeId {changedBegin}; changeId < changedEnd; ++changeId)
+                m_file.put(static_cast<char>(frame.bits[changeId] ^ m_previous.bits[changeId]));
+            byteId = changedEnd;
+        }
+        m_previous = frame;
+    }
+
+    void flushRepeats() {
+        if (m_nbRepeats == 0)
+            return;
+        writeBytes({REPEAT});
+        writeVarint(m_nbRepeats);
+        m_nbRepeats = 0;
+    }
+
+private:
+    SpscQueue<Frame, 64> m_queue;
+    std::uint64_t m_nbFrames = 0;
+    std::uint64_t m_nbDroppedFrames = 0;
+
+    std::thread m_encoderThread;
+    std::atomic<bool> m_isRecording {false};
+
+    // Only used by encoding thread while it runs
+    std::ofstream m_file;
+    Frame m_previous;
+    std::uint64_t m_nbRepeats = 0;
+};
+
+}
+
+#endif /* VideoRecorder_hpp */
@@ -5,19 +5,109 @@
 //  Created on 22/01/2020.
 //
 
+#include <iomanip>
+#include <stdexcept>
 #include <string>
 
 #include "Chip8.hpp"
 
+namespace {
+
+/**
+ \brief Parses a whole command line number, in decimal or in hexadecimal with 0x prefix
+ \param text Text of the argument
+ \return The number. Throws std::invalid_argument or std::out_of_range if text is not a positive number.
+ */
+std::uint64_t parseNumber(std::string const& text) {
+    std::size_t end = 0;
+    auto const value {std::stoull(text, &end, text.rfind("0x", 0) == 0 ? 16 : 10)};
+    if (end != text.size() || text.find('-') != std::string::npos)
+        throw std::invalid_argument("Error: invalid number " + text);
+    return value;
+}
+
+}
+
 int main(int argc, char ** argv) {
     
     std::string configFilename = "../Config.txt";
     
-    if (argc > 1)
-        configFilename = argv[1];
-    
     chp::Chip8 emulator;
-    emulator.launch(configFilename);
+    
+    if (argc > 2 && std::string(argv[1]) == "--decode-trace") {
+        if (!emulator.decodeTrace(argv[2], std::cout)) {
+            std::cout << "Error: could not read trace file " << argv[2] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
+    if (argc > 3 && std::string(argv[1]) == "--decode-video") {
+        if (!emulator.decodeVideo(argv[2], argv[3])) {
+            std::cout << "Error: could not decode video file " << argv[2] << " in directory " << argv[3] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
+    if (argc > 2 && std::string(argv[1]) == "--hash") {
+        std::ifstream gameFile(argv[2], std::ifstream::in | std::ifstream::binary);
+        if (!gameFile.is_open()) {
+            std::cout << "Error: could not read game file " << argv[2] << std::endl;
+            return 1;
+        }
+        std::vector<std::uint8_t> const game {std::istreambuf_iterator<char>(gameFile), std::istreambuf_iterator<char>()};
+        std::cout << std::hex << std::setw(16) << std::setfill('0') << chp::RomDatabase::hash(game.data(), game.size()) << std::endl;
+        return 0;
+    }
+    
+    if (argc > 4 && std::string(argv[1]) == "--screenshot") {
+        std::ifstream gameFile(argv[2], std::ifstream::in | std::ifstream::binary);
+        if (!gameFile.is_open()) {
+            std::cout << "Error: could not read game file " << argv[2] << std::endl;
+            return 1;
+        }
+        std::vector<std::uint8_t> const game {std::istreambuf_iterator<char>(gameFile), std::istreambuf_iterator<char>()};
+        
+        auto const quirks {chp::parseQuirks(argc > 5 ? argv[5] : "none")};
+        if (!quirks) {
+            std::cout << "Error: unknown quirks " << argv[5] << std::endl;
+            return 1;
+        }
+        
+        std::uint64_t nbCycles;
+        std::size_t memorySize;
+        try {
+            nbCycles = parseNumber(argv[3]);
+            memorySize = argc > 6 ? parseNumber(argv[6]) : 4096;
+        } catch (std::logic_error const&) {
+            std::cout << "Error: number of instructions and memory size must be positive numbers" << std::endl;
+            return 1;
+        }
+        
+        try {
+            emulator.initHeadless(game, *quirks, memorySize);
+        } catch (std::exception const& error) {
+            std::cout << error.what() << std::endl;
+            return 1;
+        }
+        emulator.runHeadless(nbCycles, {});
+        if (!emulator.saveScreenshot(argv[4])) {
+            std::cout << "Error: could not write screenshot in file " << argv[4] << " (extension must be .png or .ppm)" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
+    bool isStartupProfiled = false;
+    for (int argId = 1; argId < argc; ++argId) {
+        if (std::string(argv[argId]) == "--startup-profile")
+            isStartupProfiled = true;
+        else
+            configFilename = argv[argId];
+    }
+    
+    emulator.launch(configFilename, isStartupProfiled);
     
     return 0;
 }
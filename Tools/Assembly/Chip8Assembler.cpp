@@ -0,0 +1,342 @@
+//
+//  Chip8Assembler.cpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Chip8Syntax.hpp"
+
+namespace {
+
+using namespace chp;
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+        text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+        text.remove_suffix(1);
+    return text;
+}
+
+bool isEqualIgnoringCase(std::string_view lhs, std::string_view rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+    for (std::size_t charId = 0; charId < lhs.size(); ++charId) {
+        if (std::toupper(static_cast<unsigned char>(lhs[charId])) != std::toupper(static_cast<unsigned char>(rhs[charId])))
+            return false;
+    }
+    return true;
+}
+
+/**
+ \brief Parses a number: #2B, 0x2B or 43
+ \param text Text to parse, entirely
+ \return The number, or nothing if text is not a number
+ */
+std::optional<std::uint32_t> parseNumber(std::string_view text) {
+    int base = 10;
+    if (!text.empty() && text[0] == '#') {
+        text.remove_prefix(1);
+        base = 16;
+    } else if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        text.remove_prefix(2);
+        base = 16;
+    }
+
+    std::uint32_t value = 0;
+    auto const [end, error] {std::from_chars(text.data(), text.data() + text.size(), value, base)};
+    if (text.empty() || error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+    return value;
+}
+
+/**
+ \brief Class to assemble a source file into a game
+ \details Instructions are encoded in a single pass, values referring to labels are patched once the whole file is read
+ */
+class Assembler {
+public:
+    /**
+     \brief Constructor
+     \param filename Source filename, used in error messages
+     */
+    explicit Assembler(std::string filename) :
+    m_filename(std::move(filename))
+    {
+        for (std::size_t actionId = 1; actionId < OPCODES.size(); ++actionId)
+            m_syntaxes.push_back(assembly::getSyntax(OPCODES[actionId]));
+    }
+
+    /**
+     \brief Assembles source
+     \param source Stream to read the source from
+     \return The game content, or nothing if source has errors (they are printed on error output)
+     */
+    std::optional<std::vector<std::uint8_t>> assemble(std::istream & source) {
+        std::string line;
+        for (m_line = 1; std::getline(source, line); ++m_line)
+            assembleLine(line);
+
+        for (auto const& reference : m_references)
+            resolveReference(reference);
+
+        if (m_hasErrors)
+            return std::nullopt;
+        return std::move(m_game);
+    }
+
+private:
+    /**
+     \brief Value refering to a label, patched once all labels are known
+     */
+    struct Reference {
+        std::size_t offset; // Position of the opcode in the game
+        std::string label;
+        std::size_t nbNibbles; // 1 to 3 for N to NNN, 4 for the adress of LD I, LONG
+        std::size_t line;
+    };
+
+    void printError(std::string const& message) {
+        printError(message, m_line);
+    }
+
+    void printError(std::string const& message, std::size_t line) {
+        std::cerr << "Error: " << m_filename << ":" << line << ": " << message << std::endl;
+        m_hasErrors = true;
+    }
+
+    void assembleLine(std::string_view line) {
+        line = trim(line.substr(0, line.find(';')));
+
+        if (auto const colon {line.find(':')}; colon != std::string_view::npos) {
+            auto const label {trim(line.substr(0, colon))};
+            if (!assembly::isLabelName(label))
+                printError("invalid label " + std::string(label));
+            else if (!m_labels.emplace(std::string(label), static_cast<std::uint32_t>(assembly::BASE_ADRESS + m_game.size())).second)
+                printError("label " + std::string(label) + " is already defined");
+            line = trim(line.substr(colon + 1));
+        }
+        if (line.empty())
+            return;
+
+        auto const nameEnd {std::min(line.find_first_of(" \t"), line.size())};
+        auto const name {line.substr(0, nameEnd)};
+        std::vector<std::string_view> operands;
+        for (auto rest {trim(line.substr(nameEnd))}; !rest.empty();) {
+            auto const comma {std::min(rest.find(','), rest.size())};
+            operands.push_back(trim(rest.substr(0, comma)));
+            rest = comma < rest.size() ? trim(rest.substr(comma + 1)) : std::string_view();
+        }
+
+        if (isEqualIgnoringCase(name, "DB"))
+            assembleData(operands);
+        else
+            assembleInstruction(name, operands);
+    }
+
+    void assembleData(std::vector<std::string_view> const& operands) {
+        for (auto const operand : operands) {
+            auto const value {parseNumber(operand)};
+            if (!value || *value > 0xFF)
+                printError("invalid byte " + std::string(operand));
+            else
+                m_game.push_back(static_cast<std::uint8_t>(*value));
+        }
+    }
+
+    void assembleInstruction(std::string_view name, std::vector<std::string_view> const& operands) {
+        bool isNameKnown = false;
+        for (std::size_t syntaxId = 0; syntaxId < m_syntaxes.size(); ++syntaxId) {
+            auto const& syntax {m_syntaxes[syntaxId]};
+            if (!isEqualIgnoringCase(syntax.name, name))
+                continue;
+            isNameKnown = true;
+
+            auto const nbOperands {syntax.operands.size()};
+            if (operands.size() != nbOperands && !(syntax.isYImplicit && operands.size() + 1 == nbOperands))
+                continue;
+
+            Encoding encoding;
+            bool isMatching = true;
+            for (std::size_t operandId = 0; isMatching && operandId < operands.size(); ++operandId)
+                isMatching = matchOperand(syntax.operands[operandId], operands[operandId], encoding);
+            if (!isMatching)
+                continue;
+
+            auto const& info {OPCODES[syntaxId + 1]};
+            auto const offset {m_game.size()};
+            auto const isLongLoad {assembly::isLongLoad(info)};
+            std::uint16_t const opcode = info.identifier | (encoding.x << 8) | (encoding.y << 4) | (isLongLoad ? 0 : encoding.value);
+            m_game.push_back(static_cast<std::uint8_t>(opcode >> 8));
+            m_game.push_back(static_cast<std::uint8_t>(opcode & 0xFF));
+            if (isLongLoad) {
+                m_game.push_back(static_cast<std::uint8_t>(encoding.value >> 8));
+                m_game.push_back(static_cast<std::uint8_t>(encoding.value & 0xFF));
+            }
+
+            if (!encoding.label.empty())
+                m_references.push_back({offset, std::move(encoding.label), encoding.nbNibbles, m_line});
+            else if (encoding.value >= (1u << (4 * encoding.nbNibbles)))
+                printError("value " + assembly::formatValue(encoding.value, 1) + " does not fit in " + std::string(info.pattern));
+            return;
+        }
+
+        if (!isNameKnown)
+            printError("unknown instruction " + std::string(name));
+        else
+            printError("invalid operands for " + std::string(name));
+    }
+
+    /**
+     \brief Fields of an opcode, read from its operands
+     */
+    struct Encoding {
+        std::uint16_t x = 0;
+        std::uint16_t y = 0;
+        std::uint32_t value = 0; // Only set if value is not a label
+        std::string label;
+        std::size_t nbNibbles = 0;
+    };
+
+    /**
+     \brief Matches operand with an operand template of a mnemonic
+     \param pattern Operand template, for example VX, NNN or [I]
+     \param operand Operand written in source
+     \param encoding Fields filled by the operand
+     \return True if operand matches the template
+     */
+    static bool matchOperand(std::string_view pattern, std::string_view operand, Encoding & encoding) {
+        if (auto const nbNibbles {assembly::getNbValueNibbles(pattern)}; nbNibbles > 0)
+            return matchValue(operand, nbNibbles, encoding);
+
+        if (pattern == "LONG") {
+            auto const keywordEnd {std::min(operand.find_first_of(" \t"), operand.size())};
+            return isEqualIgnoringCase(operand.substr(0, keywordEnd), "LONG") && matchValue(trim(operand.substr(keywordEnd)), 4, encoding);
+        }
+
+        std::size_t charId = 0;
+        for (char c : pattern) {
+            if (charId >= operand.size())
+                return false;
+
+            auto const operandChar {static_cast<unsigned char>(operand[charId++])};
+            if (c == 'X' || c == 'Y') {
+                if (!std::isxdigit(operandChar))
+                    return false;
+                auto const digit {static_cast<std::uint16_t>(std::isdigit(operandChar) ? operandChar - '0' : std::toupper(operandChar) - 'A' + 10)};
+                (c == 'X' ? encoding.x : encoding.y) = digit;
+            } else if (std::toupper(operandChar) != c) {
+                return false;
+            }
+        }
+        return charId == operand.size();
+    }
+
+    static bool matchValue(std::string_view operand, std::size_t nbNibbles, Encoding & encoding) {
+        encoding.nbNibbles = nbNibbles;
+        if (auto const value {parseNumber(operand)}) {
+            encoding.value = *value;
+            return true;
+        }
+        if (!assembly::isLabelName(operand))
+            return false;
+        encoding.label = operand;
+        return true;
+    }
+
+    void resolveReference(Reference const& reference) {
+        auto const label {m_labels.find(reference.label)};
+        if (label == m_labels.end()) {
+            printError("undefined label " + reference.label, reference.line);
+            return;
+        }
+
+        auto const value {label->second};
+        if (value >= (1u << (4 * reference.nbNibbles))) {
+            printError("label " + reference.label + " is out of range", reference.line);
+            return;
+        }
+
+        if (reference.nbNibbles == 4) {
+            m_game[reference.offset + 2] = static_cast<std::uint8_t>(value >> 8);
+            m_game[reference.offset + 3] = static_cast<std::uint8_t>(value & 0xFF);
+        } else {
+            m_game[reference.offset] |= static_cast<std::uint8_t>(value >> 8);
+            m_game[reference.offset + 1] |= static_cast<std::uint8_t>(value & 0xFF);
+        }
+    }
+
+private:
+    std::string m_filename;
+    std::size_t m_line = 0;
+    bool m_hasErrors = false;
+
+    std::vector<assembly::Syntax> m_syntaxes; // Indexed by action id - 1, unknown opcodes cannot be assembled
+    std::vector<std::uint8_t> m_game;
+    std::unordered_map<std::string, std::uint32_t> m_labels;
+    std::vector<Reference> m_references;
+};
+
+}
+
+/**
+ \brief Assembles sources: chip8-as [-o <output directory>] <source files>...
+ \details Each source is written in a .ch8 file, next to it if no output directory is given
+ */
+int main(int argc, char ** argv) {
+    std::string outputDirectory;
+    std::vector<std::string> sourceFilenames;
+    for (int argId = 1; argId < argc; ++argId) {
+        if (std::string(argv[argId]) == "-o" && argId + 1 < argc)
+            outputDirectory = argv[++argId];
+        else
+            sourceFilenames.push_back(argv[argId]);
+    }
+
+    if (sourceFilenames.empty()) {
+        std::cerr << "Usage: chip8-as [-o <output directory>] <source files>..." << std::endl;
+        return 1;
+    }
+
+    int result = 0;
+    for (auto const& sourceFilename : sourceFilenames) {
+        std::ifstream sourceFile(sourceFilename);
+        if (!std::filesystem::is_regular_file(sourceFilename) || !sourceFile.is_open()) {
+            std::cerr << "Error: could not read source file " << sourceFilename << std::endl;
+            result = 1;
+            continue;
+        }
+
+        auto const game {Assembler(sourceFilename).assemble(sourceFile)};
+        if (!game) {
+            result = 1;
+            continue;
+        }
+
+        std::filesystem::path outputFilename {sourceFilename};
+        if (!outputDirectory.empty())
+            outputFilename = std::filesystem::path(outputDirectory) / outputFilename.filename();
+        outputFilename.replace_extension(".ch8");
+
+        std::ofstream outputFile(outputFilename, std::ios::binary);
+        if (!outputFile.write(reinterpret_cast<char const*>(game->data()), static_cast<std::streamsize>(game->size()))) {
+            std::cerr << "Error: could not write file " << outputFilename.string() << std::endl;
+            result = 1;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,195 @@
+//
+//  Chip8Disassembler.cpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Chip8Syntax.hpp"
+#include "ControlFlowGraph.hpp"
+
+namespace {
+
+using namespace chp;
+
+/**
+ \brief Class to disassemble a whole game
+ \details Instructions are found by the control flow graph of the emulator, bytes never reached from the entry point are written as data
+ */
+class Disassembler {
+public:
+    /**
+     \brief Constructor
+     \param game Game content, loaded at assembly::BASE_ADRESS
+     */
+    explicit Disassembler(std::vector<std::uint8_t> const& game) :
+    m_game(game)
+    {
+    }
+
+    /**
+     \brief Disassembles game
+     \param output Stream to write the assembly in
+     */
+    void disassemble(std::ostream & output) {
+        m_graph.analyze(m_game.data(), m_game.size(), assembly::BASE_ADRESS);
+
+        for (std::size_t offset = 0; offset < m_game.size();) {
+            if (hasLabel(offset))
+                output << getLabelName(offset) << ":\n";
+
+            if (isInstruction(offset))
+                offset += writeInstruction(offset, output);
+            else
+                offset += writeData(offset, output);
+        }
+    }
+
+private:
+    std::uint16_t getOpcode(std::size_t offset) const {
+        return (m_game[offset] << 8) | m_game[offset + 1];
+    }
+
+    bool isInstruction(std::size_t offset) const {
+        return m_graph.getByteKind(offset + assembly::BASE_ADRESS) == ControlFlowGraph::ByteKind::Instruction;
+    }
+
+    bool hasLabel(std::size_t offset) const {
+        auto const adress {offset + assembly::BASE_ADRESS};
+        return m_graph.getTarget(adress) != ControlFlowGraph::Target::None && m_graph.getByteKind(adress) != ControlFlowGraph::ByteKind::Operand;
+    }
+
+    std::string getLabelName(std::size_t offset) const {
+        static char const* const prefixes[] {"", "data_", "label_", "sub_", ""}; // Indexed by ControlFlowGraph::Target
+        auto const target {m_graph.getTarget(offset + assembly::BASE_ADRESS)};
+        if (target == ControlFlowGraph::Target::Entry)
+            return "start";
+
+        char name[16];
+        std::snprintf(name, sizeof(name), "%s%03zX", prefixes[static_cast<int>(target)], offset + assembly::BASE_ADRESS);
+        return name;
+    }
+
+    /**
+     \brief Formats adress, as a label if it has one
+     */
+    std::string formatAdress(std::uint32_t adress, int nbDigits) const {
+        if (m_graph.contains(adress) && hasLabel(adress - assembly::BASE_ADRESS))
+            return getLabelName(adress - assembly::BASE_ADRESS);
+        return assembly::formatValue(adress, nbDigits);
+    }
+
+    std::size_t writeInstruction(std::size_t offset, std::ostream & output) const {
+        auto const opcode {getOpcode(offset)};
+        auto const& info {OPCODES[decodeOpcode(opcode)]};
+        auto const syntax {assembly::getSyntax(info)};
+
+        auto nbOperands {syntax.operands.size()};
+        if (syntax.isYImplicit && ((opcode >> 4) & 0xF) == 0)
+            --nbOperands;
+
+        output << "    " << syntax.name;
+        for (std::size_t operandId = 0; operandId < nbOperands; ++operandId) {
+            output << (operandId == 0 ? " " : ", ");
+
+            auto const operand {syntax.operands[operandId]};
+            if (auto const nbNibbles {assembly::getNbValueNibbles(operand)}; nbNibbles == 3) {
+                output << formatAdress(opcode & 0x0FFF, 3);
+            } else if (nbNibbles > 0) {
+                output << assembly::formatValue(opcode & ((1 << (4 * nbNibbles)) - 1), static_cast<int>(nbNibbles));
+            } else if (operand == "LONG") {
+                output << "LONG " << formatAdress(getOpcode(offset + 2), 4);
+            } else {
+                for (char c : operand) {
+                    if (c == 'X')
+                        output << assembly::formatValue((opcode >> 8) & 0xF, 1).substr(1);
+                    else if (c == 'Y')
+                        output << assembly::formatValue((opcode >> 4) & 0xF, 1).substr(1);
+                    else
+                        output << c;
+                }
+            }
+        }
+        output << "\n";
+
+        return assembly::isLongLoad(info) ? 4 : 2;
+    }
+
+    std::size_t writeData(std::size_t offset, std::ostream & output) const {
+        constexpr std::size_t NB_BYTES_PER_LINE = 8;
+
+        output << "    DB ";
+        std::size_t nbBytes = 0;
+        do {
+            output << (nbBytes == 0 ? "" : ", ") << assembly::formatValue(m_game[offset + nbBytes], 2);
+            ++nbBytes;
+        } while (nbBytes < NB_BYTES_PER_LINE && offset + nbBytes < m_game.size() && !m_graph.isCode(offset + nbBytes + assembly::BASE_ADRESS) && !hasLabel(offset + nbBytes));
+        output << "\n";
+
+        return nbBytes;
+    }
+
+private:
+    std::vector<std::uint8_t> const& m_game;
+    ControlFlowGraph m_graph;
+};
+
+}
+
+/**
+ \brief Disassembles games: chip8-dis [-o <output directory>] <game files>...
+ \details Without output directory, assembly is written on the standard output. Otherwise each game is written in a .c8s file of the directory.
+ */
+int main(int argc, char ** argv) {
+    std::string outputDirectory;
+    std::vector<std::string> gameFilenames;
+    for (int argId = 1; argId < argc; ++argId) {
+        if (std::string(argv[argId]) == "-o" && argId + 1 < argc)
+            outputDirectory = argv[++argId];
+        else
+            gameFilenames.push_back(argv[argId]);
+    }
+
+    if (gameFilenames.empty()) {
+        std::cerr << "Usage: chip8-dis [-o <output directory>] <game files>..." << std::endl;
+        return 1;
+    }
+
+    int result = 0;
+    for (auto const& gameFilename : gameFilenames) {
+        std::ifstream gameFile(gameFilename, std::ios::binary);
+        if (!std::filesystem::is_regular_file(gameFilename) || !gameFile.is_open()) {
+            std::cerr << "Error: could not read game file " << gameFilename << std::endl;
+            result = 1;
+            continue;
+        }
+        std::vector<std::uint8_t> const game {std::istreambuf_iterator<char>(gameFile), std::istreambuf_iterator<char>()};
+
+        std::ostringstream assembly;
+        assembly << "; " << std::filesystem::path(gameFilename).filename().string() << ", " << game.size() << " bytes\n";
+        Disassembler(game).disassemble(assembly);
+
+        if (outputDirectory.empty()) {
+            std::cout << assembly.str();
+            continue;
+        }
+
+        auto const outputFilename {(std::filesystem::path(outputDirectory) / std::filesystem::path(gameFilename).filename()).replace_extension(".c8s")};
+        std::ofstream outputFile(outputFilename);
+        if (!(outputFile << assembly.str())) {
+            std::cerr << "Error: could not write file " << outputFilename.string() << std::endl;
+            result = 1;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,131 @@
+//
+//  Chip8Syntax.hpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#ifndef Chip8Syntax_hpp
+#define Chip8Syntax_hpp
+
+# include <algorithm>
+# include <cctype>
+# include <cstdint>
+# include <cstdio>
+# include <string>
+# include <string_view>
+# include <vector>
+
+# include "Opcodes.hpp"
+
+namespace chp {
+
+/**
+ \brief Assembly syntax shared by chip8-dis and chip8-as
+ \details Instructions are written as the mnemonics of OPCODES. X and Y are replaced by a register number in hexadecimal, N, NN and NNN by a value (#2B, 43 or a label). LD I, LONG is followed by its 16 bits adress.
+ */
+namespace assembly {
+
+/**
+ \brief Adress where games are loaded
+ */
+constexpr std::uint32_t BASE_ADRESS = 0x200;
+
+/**
+ \brief Instruction name and operand templates of a mnemonic
+ \details For example, "LD VX, NN" is split in "LD", {"VX", "NN"}
+ */
+struct Syntax {
+    std::string_view name;
+    std::vector<std::string_view> operands;
+    bool isYImplicit = false; // Last operand VY is not in the mnemonic (SHR VX) and can be omitted when Y is 0
+};
+
+/**
+ \brief Splits mnemonic in instruction name and operand templates
+ \param opcode Instruction to get the syntax of
+ \return The syntax of the instruction
+ */
+inline Syntax getSyntax(OpcodeInfo const& opcode) {
+    Syntax syntax;
+    auto const mnemonic {opcode.mnemonic};
+    auto const delimiter {std::min(mnemonic.find(' '), mnemonic.size())};
+    syntax.name = mnemonic.substr(0, delimiter);
+
+    for (auto begin {delimiter + 1}; begin < mnemonic.size();) {
+        auto const end {std::min(mnemonic.find(", ", begin), mnemonic.size())};
+        syntax.operands.push_back(mnemonic.substr(begin, end - begin));
+        begin = end + 2;
+    }
+
+    // Y is not used by every interpreter but is still part of the opcode, so it must be kept to reassemble it
+    if (opcode.pattern.find('Y') != std::string_view::npos && mnemonic.find('Y') == std::string_view::npos) {
+        syntax.operands.push_back("VY");
+        syntax.isYImplicit = true;
+    }
+    return syntax;
+}
+
+/**
+ \brief Checks if instruction is followed by a 16 bits adress (XO-CHIP F000)
+ \param opcode Instruction to check
+ \return True if instruction takes 4 bytes
+ */
+constexpr bool isLongLoad(OpcodeInfo const& opcode) {
+    return opcode.pattern == "F000";
+}
+
+/**
+ \brief Gets number of value nibbles of an operand template
+ \param operand Operand template
+ \return 1, 2 or 3 for N, NN and NNN, 0 if operand is not a value
+ */
+inline std::size_t getNbValueNibbles(std::string_view operand) {
+    if (operand == "N" || operand == "NN" || operand == "NNN")
+        return operand.size();
+    return 0;
+}
+
+/**
+ \brief Formats value in assembly hexadecimal notation
+ \param value Value to format
+ \param nbDigits Minimum number of digits
+ \return The value, for example #2B
+ */
+inline std::string formatValue(std::uint32_t value, int nbDigits) {
+    char text[8];
+    std::snprintf(text, sizeof(text), "#%0*X", nbDigits, value);
+    return text;
+}
+
+/**
+ \brief Checks if name can be used as a label
+ \details Register names and operand keywords (I, DT, K...) are reserved
+ \param name Name to check
+ \return True if name is a valid label
+ */
+inline bool isLabelName(std::string_view name) {
+    if (name.empty() || !(std::isalpha(static_cast<unsigned char>(name[0])) || name[0] == '_'))
+        return false;
+    for (char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_')
+            return false;
+    }
+
+    std::string upperName(name);
+    for (auto & c : upperName)
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    if (upperName.size() == 2 && upperName[0] == 'V' && std::isxdigit(static_cast<unsigned char>(upperName[1])))
+        return false;
+    for (auto const keyword : {"I", "DT", "ST", "K", "F", "HF", "R", "LONG"}) {
+        if (upperName == keyword)
+            return false;
+    }
+    return true;
+}
+
+}
+
+}
+
+#endif /* Chip8Syntax_hpp */
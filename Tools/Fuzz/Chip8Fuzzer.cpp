@@ -0,0 +1,95 @@
+//
+//  Chip8Fuzzer.cpp
+//  Chip-8_Emulator
+//
+//  Created on 19/10/2026.
+//
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Chip8.hpp"
+
+namespace {
+
+constexpr std::uint64_t NB_CYCLES = 20000;
+constexpr std::size_t MAX_INPUT_SIZE = 4096;
+
+/**
+ \brief Runs one fuzzing input in a headless emulator
+ \details First byte is the number of keypad changes. Each change takes 2 bytes: the delay in cycles since the previous change, then the key id in the 4 least significant bits and the pressed state in the most significant bit. Remaining bytes are the game.
+ \param data Bytes of the input
+ \param size Number of bytes
+ */
+void runInput(std::uint8_t const* data, std::size_t size) {
+    static chp::Chip8 emulator;
+    
+    std::vector<chp::Chip8::KeyInput> inputs;
+    std::size_t pos = 0;
+    
+    if (size > 0) {
+        std::size_t const nbInputs = data[pos++];
+        std::uint64_t cycle = 0;
+        for (std::size_t inputId = 0; inputId < nbInputs && pos + 1 < size; ++inputId, pos += 2) {
+            cycle += data[pos];
+            inputs.push_back({cycle, static_cast<std::uint8_t>(data[pos + 1] & 0x0F), (data[pos + 1] & 0x80) != 0});
+        }
+    }
+    
+    emulator.initHeadless(std::vector<std::uint8_t>(data + pos, data + size));
+    emulator.runHeadless(NB_CYCLES, inputs);
+}
+
+}
+
+extern "C" int LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size) {
+    // Games make the interpreter print errors, which would slow fuzzing down a lot
+    std::cout.setstate(std::ios::failbit);
+    
+    runInput(data, size);
+    return 0;
+}
+
+#ifndef CHIP8_LIBFUZZER
+
+/**
+ \brief Standalone driver used when libFuzzer is not available
+ \details With file arguments, runs each file once to reproduce a crash. Otherwise runs random inputs: chip8-fuzz [nbRuns] [seed]
+ */
+int main(int argc, char ** argv) {
+    if (argc > 1 && std::ifstream(argv[1]).is_open()) {
+        for (int argId = 1; argId < argc; ++argId) {
+            std::ifstream file(argv[argId], std::ios::binary);
+            std::vector<std::uint8_t> const data {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            std::cerr << "Running " << argv[argId] << " (" << data.size() << " bytes)" << std::endl;
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        return 0;
+    }
+    
+    std::uint64_t const nbRuns = argc > 1 ? std::stoull(argv[1]) : 10000;
+    std::uint64_t const seed = argc > 2 ? std::stoull(argv[2]) : std::random_device()();
+    
+    std::mt19937_64 generator(seed);
+    std::vector<std::uint8_t> data;
+    
+    for (std::uint64_t runId = 0; runId < nbRuns; ++runId) {
+        data.resize(generator() % MAX_INPUT_SIZE);
+        for (auto & byte : data)
+            byte = static_cast<std::uint8_t>(generator());
+        
+        // Written before running so that the input causing an abort is kept
+        std::ofstream("chip8-fuzz-last.bin", std::ios::binary).write(reinterpret_cast<char const*>(data.data()), data.size());
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    
+    std::cerr << nbRuns << " runs without error (seed " << seed << ")" << std::endl;
+    return 0;
+}
+
+#endif
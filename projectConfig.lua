@@ -28,4 +28,106 @@ project "Chip-8"
 
    libdirs {
       "SFML/lib"
-   }
\ No newline at end of file
+   }
+
+project "Chip-8-Fuzz"
+   kind "ConsoleApp"
+
+   language "C++"
+   cppdialect("C++17")
+
+   targetdir "Executable/%{cfg.buildcfg}"
+   targetname "chip8-fuzz"
+
+   files {
+         "Chip-8_Emulator/**.hpp",
+         "Chip-8_Emulator/**.cpp",
+         "Chip-8_Emulator/**.h",
+         "Tools/Fuzz/**.cpp"
+      }
+
+   removefiles {
+      "Chip-8_Emulator/main.cpp"
+   }
+
+   defines {
+      "CHIP8_BOUNDS_CHECKS"
+   }
+
+   includedirs {
+      "SFML/include",
+      "Chip-8_Emulator"
+   }
+
+   links {
+      "sfml-graphics",
+      "sfml-window",
+      "sfml-system",
+      "sfml-audio"
+   }
+
+   libdirs {
+      "SFML/lib"
+   }
+
+   -- Sanitizers are available with clang and gcc. Building with --fuzzer=libfuzzer links libFuzzer instead of the standalone driver.
+   filter { "toolset:clang or toolset:gcc" }
+      buildoptions { "-fsanitize=address,undefined", "-fno-omit-frame-pointer" }
+      linkoptions { "-fsanitize=address,undefined" }
+
+   filter { "options:fuzzer=libfuzzer" }
+      defines { "CHIP8_LIBFUZZER" }
+      buildoptions { "-fsanitize=fuzzer" }
+      linkoptions { "-fsanitize=fuzzer" }
+
+   filter {}
+
+project "Chip-8-Dis"
+   kind "ConsoleApp"
+
+   language "C++"
+   cppdialect("C++17")
+
+   targetdir "Executable/%{cfg.buildcfg}"
+   targetname "chip8-dis"
+
+   files {
+         "Chip-8_Emulator/Opcodes.hpp",
+         "Tools/Assembly/Chip8Syntax.hpp",
+         "Tools/Assembly/Chip8Disassembler.cpp"
+      }
+
+   includedirs {
+      "Chip-8_Emulator",
+      "Tools/Assembly"
+   }
+
+project "Chip-8-As"
+   kind "ConsoleApp"
+
+   language "C++"
+   cppdialect("C++17")
+
+   targetdir "Executable/%{cfg.buildcfg}"
+   targetname "chip8-as"
+
+   files {
+         "Chip-8_Emulator/Opcodes.hpp",
+         "Tools/Assembly/Chip8Syntax.hpp",
+         "Tools/Assembly/Chip8Assembler.cpp"
+      }
+
+   includedirs {
+      "Chip-8_Emulator",
+      "Tools/Assembly"
+   }
+
+newoption {
+   trigger = "fuzzer",
+   value = "ENGINE",
+   description = "Fuzzing engine linked in Chip-8-Fuzz",
+   allowed = {
+      { "standalone", "Random inputs driver, no dependency" },
+      { "libfuzzer", "Coverage guided libFuzzer, needs clang" }
+   }
+}